@@ -0,0 +1,115 @@
+#include "Rendering/Voxel/VoxelBrickMap.h"
+
+void FVoxelBrickMap::Reset()
+{
+    Centers.Reset();
+    Scales.Reset();
+    BrickCoords.Reset();
+    BrickToSlot.Reset();
+    Occupancy.Reset();
+    SlotCellCounts.Reset();
+    FreeSlots.Reset();
+    OccupiedCellCount = 0;
+}
+
+int32 FVoxelBrickMap::FindAtlasIndex(const FIntVector& Cell) const
+{
+    const int32* Slot = BrickToSlot.Find(CellToBrick(Cell));
+    return Slot ? *Slot * CellsPerBrick + CellToLocalIndex(Cell) : INDEX_NONE;
+}
+
+bool FVoxelBrickMap::IsCellOccupied(const FIntVector& Cell) const
+{
+    const int32* Slot = BrickToSlot.Find(CellToBrick(Cell));
+    if (!Slot) return false;
+    const int32 LocalIndex = CellToLocalIndex(Cell);
+    return (Occupancy[*Slot * OccupancyWordsPerBrick + (LocalIndex >> 6)] & (1ull << (LocalIndex & 63))) != 0;
+}
+
+bool FVoxelBrickMap::FindCell(const FIntVector& Cell, FVector3f& OutCenter, float& OutScale) const
+{
+    if (!IsCellOccupied(Cell)) return false;
+    const int32 AtlasIndex = FindAtlasIndex(Cell);
+    OutCenter = Centers[AtlasIndex];
+    OutScale  = Scales[AtlasIndex];
+    return true;
+}
+
+int32 FVoxelBrickMap::AllocateSlot(const FIntVector& BrickCoord)
+{
+    int32 Slot = INDEX_NONE;
+    if (FreeSlots.Num() > 0)
+    {
+        Slot = FreeSlots.Pop(EAllowShrinking::No);
+    }
+    else
+    {
+        Slot = BrickCoords.AddDefaulted();
+        Centers.AddZeroed(CellsPerBrick);
+        Scales.AddZeroed(CellsPerBrick);
+        Occupancy.AddZeroed(OccupancyWordsPerBrick);
+        SlotCellCounts.Add(0);
+    }
+    BrickCoords[Slot] = FIntVector4(BrickCoord.X, BrickCoord.Y, BrickCoord.Z, 1);
+    BrickToSlot.Add(BrickCoord, Slot);
+    return Slot;
+}
+
+int32 FVoxelBrickMap::SetCell(const FIntVector& Cell, const FVector3f& Center, float Scale)
+{
+    const FIntVector BrickCoord = CellToBrick(Cell);
+    const int32* ExistingSlot = BrickToSlot.Find(BrickCoord);
+    const int32 Slot = ExistingSlot ? *ExistingSlot : AllocateSlot(BrickCoord);
+
+    const int32 LocalIndex = CellToLocalIndex(Cell);
+    uint64& Word = Occupancy[Slot * OccupancyWordsPerBrick + (LocalIndex >> 6)];
+    const uint64 Bit = 1ull << (LocalIndex & 63);
+    if ((Word & Bit) == 0)
+    {
+        Word |= Bit;
+        ++SlotCellCounts[Slot];
+        ++OccupiedCellCount;
+    }
+
+    const int32 AtlasIndex = Slot * CellsPerBrick + LocalIndex;
+    Centers[AtlasIndex] = Center;
+    Scales[AtlasIndex]  = Scale;
+    return AtlasIndex;
+}
+
+void FVoxelBrickMap::ClearCell(const FIntVector& Cell)
+{
+    const FIntVector BrickCoord = CellToBrick(Cell);
+    const int32* SlotPtr = BrickToSlot.Find(BrickCoord);
+    if (!SlotPtr) return;
+    const int32 Slot = *SlotPtr;
+
+    const int32 LocalIndex = CellToLocalIndex(Cell);
+    uint64& Word = Occupancy[Slot * OccupancyWordsPerBrick + (LocalIndex >> 6)];
+    const uint64 Bit = 1ull << (LocalIndex & 63);
+    if ((Word & Bit) == 0) return;
+
+    Word &= ~Bit;
+    --OccupiedCellCount;
+    const int32 AtlasIndex = Slot * CellsPerBrick + LocalIndex;
+    Centers[AtlasIndex] = FVector3f::ZeroVector;
+    Scales[AtlasIndex]  = 0.0f;
+
+    if (--SlotCellCounts[Slot] == 0)
+    {
+        BrickCoords[Slot].W = 0;
+        BrickToSlot.Remove(BrickCoord);
+        FreeSlots.Add(Slot);
+    }
+}
+
+SIZE_T FVoxelBrickMap::GetAllocatedSize() const
+{
+    return Centers.GetAllocatedSize()
+        + Scales.GetAllocatedSize()
+        + BrickCoords.GetAllocatedSize()
+        + BrickToSlot.GetAllocatedSize()
+        + Occupancy.GetAllocatedSize()
+        + SlotCellCounts.GetAllocatedSize()
+        + FreeSlots.GetAllocatedSize();
+}
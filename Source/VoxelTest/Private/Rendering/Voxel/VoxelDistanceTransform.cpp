@@ -0,0 +1,227 @@
+#include "Rendering/Voxel/VoxelDistanceTransform.h"
+
+#include "HAL/IConsoleManager.h"
+#include "Math/RandomStream.h"
+#include "VoxelTest.h"
+
+static int32 GetVoxelLinearIndex(const FIntVector& Dims, int32 X, int32 Y, int32 Z)
+{
+    return X + Dims.X * (Y + Dims.Y * Z);
+}
+
+// 1D lower envelope of parabolas rooted at sites with height F (F < 0 = no site)
+static void ComputeSquaredEdt1D(const TArray<float>& F, TArray<float>& Out, TArray<int32>& Sites, TArray<float>& Starts)
+{
+    const int32 N = F.Num();
+    Sites.SetNumUninitialized(N, EAllowShrinking::No);
+    Starts.SetNumUninitialized(N, EAllowShrinking::No);
+
+    int32 K = -1;
+    for (int32 Q = 0; Q < N; ++Q)
+    {
+        if (F[Q] < 0.0f) continue;
+
+        float S = -1e20f;
+        while (K >= 0)
+        {
+            const int32 V = Sites[K];
+            S = ((F[Q] + Q * Q) - (F[V] + V * V)) / (2.0f * (Q - V));
+            if (S > Starts[K]) break;
+            --K;
+        }
+        ++K;
+        Sites[K]  = Q;
+        Starts[K] = K == 0 ? -1e20f : S;
+    }
+
+    const int32 Count = K + 1;
+    int32 Segment = 0;
+    for (int32 X = 0; X < N; ++X)
+    {
+        if (Count == 0)
+        {
+            Out[X] = -1.0f;
+            continue;
+        }
+        while (Segment + 1 < Count && Starts[Segment + 1] <= float(X)) { ++Segment; }
+        const int32 Site = Sites[Segment];
+        Out[X] = float((X - Site) * (X - Site)) + F[Site];
+    }
+}
+
+void ComputeVoxelSquaredEdt(const FIntVector& Dims, const TArray<bool>& Sites, TArray<float>& OutSquaredDistances)
+{
+    const int32 NumCells = Dims.X * Dims.Y * Dims.Z;
+    check(Sites.Num() == NumCells);
+
+    OutSquaredDistances.SetNumUninitialized(NumCells);
+    for (int32 Index = 0; Index < NumCells; ++Index)
+    {
+        OutSquaredDistances[Index] = Sites[Index] ? 0.0f : -1.0f;
+    }
+
+    TArray<float> Line, LineOut, Starts;
+    TArray<int32> EnvelopeSites;
+    for (int32 Axis = 0; Axis < 3; ++Axis)
+    {
+        const int32 Length = Dims[Axis];
+        const int32 DimA = Axis == 0 ? Dims.Y : Dims.X;
+        const int32 DimB = Axis == 2 ? Dims.Y : Dims.Z;
+        Line.SetNumUninitialized(Length, EAllowShrinking::No);
+        LineOut.SetNumUninitialized(Length, EAllowShrinking::No);
+
+        for (int32 B = 0; B < DimB; ++B)
+        {
+            for (int32 A = 0; A < DimA; ++A)
+            {
+                auto GetIndex = [&](int32 I)
+                {
+                    return Axis == 0 ? GetVoxelLinearIndex(Dims, I, A, B)
+                         : Axis == 1 ? GetVoxelLinearIndex(Dims, A, I, B)
+                         :             GetVoxelLinearIndex(Dims, A, B, I);
+                };
+
+                for (int32 I = 0; I < Length; ++I) { Line[I] = OutSquaredDistances[GetIndex(I)]; }
+                ComputeSquaredEdt1D(Line, LineOut, EnvelopeSites, Starts);
+                for (int32 I = 0; I < Length; ++I) { OutSquaredDistances[GetIndex(I)] = LineOut[I]; }
+            }
+        }
+    }
+}
+
+void ComputeVoxelSquaredJfa(const FIntVector& Dims, const TArray<bool>& Sites, TArray<float>& OutSquaredDistances)
+{
+    const int32 NumCells = Dims.X * Dims.Y * Dims.Z;
+    check(Sites.Num() == NumCells);
+    check(FMath::Max3(Dims.X, Dims.Y, Dims.Z) <= GVoxelPackedSeedMaxDim);
+
+    TArray<uint32> Ping, Pong;
+    Ping.SetNumUninitialized(NumCells);
+    Pong.SetNumUninitialized(NumCells);
+    for (int32 Z = 0; Z < Dims.Z; ++Z)
+    for (int32 Y = 0; Y < Dims.Y; ++Y)
+    for (int32 X = 0; X < Dims.X; ++X)
+    {
+        const int32 Index = GetVoxelLinearIndex(Dims, X, Y, Z);
+        Ping[Index] = Sites[Index] ? PackVoxelSeedCell(FIntVector(X, Y, Z)) : GVoxelPackedSeedInvalid;
+    }
+
+    auto GetDistanceSq = [](uint32 Seed, const FIntVector& Cell)
+    {
+        const FIntVector D = UnpackVoxelSeedCell(Seed) - Cell;
+        return D.X * D.X + D.Y * D.Y + D.Z * D.Z;
+    };
+
+    const int32 MaxDim = FMath::Max3(Dims.X, Dims.Y, Dims.Z);
+    for (int32 Step = 1 << (31 - FMath::CountLeadingZeros(MaxDim)); Step >= 1; Step >>= 1)
+    {
+        for (int32 Z = 0; Z < Dims.Z; ++Z)
+        for (int32 Y = 0; Y < Dims.Y; ++Y)
+        for (int32 X = 0; X < Dims.X; ++X)
+        {
+            const FIntVector Cell(X, Y, Z);
+            uint32 Best = Ping[GetVoxelLinearIndex(Dims, X, Y, Z)];
+            int32 BestDist2 = Best != GVoxelPackedSeedInvalid ? GetDistanceSq(Best, Cell) : MAX_int32;
+
+            for (int32 DZ = -1; DZ <= 1; ++DZ)
+            for (int32 DY = -1; DY <= 1; ++DY)
+            for (int32 DX = -1; DX <= 1; ++DX)
+            {
+                if (DX == 0 && DY == 0 && DZ == 0) continue;
+
+                const FIntVector P = Cell + FIntVector(DX, DY, DZ) * Step;
+                if (P.X < 0 || P.Y < 0 || P.Z < 0 || P.X >= Dims.X || P.Y >= Dims.Y || P.Z >= Dims.Z) continue;
+
+                const uint32 S = Ping[GetVoxelLinearIndex(Dims, P.X, P.Y, P.Z)];
+                if (S == GVoxelPackedSeedInvalid) continue;
+
+                const int32 Dist2 = GetDistanceSq(S, Cell);
+                if (Dist2 < BestDist2)
+                {
+                    Best = S;
+                    BestDist2 = Dist2;
+                }
+            }
+            Pong[GetVoxelLinearIndex(Dims, X, Y, Z)] = Best;
+        }
+        Swap(Ping, Pong);
+    }
+
+    OutSquaredDistances.SetNumUninitialized(NumCells);
+    for (int32 Z = 0; Z < Dims.Z; ++Z)
+    for (int32 Y = 0; Y < Dims.Y; ++Y)
+    for (int32 X = 0; X < Dims.X; ++X)
+    {
+        const int32 Index = GetVoxelLinearIndex(Dims, X, Y, Z);
+        OutSquaredDistances[Index] = Ping[Index] != GVoxelPackedSeedInvalid ? float(GetDistanceSq(Ping[Index], FIntVector(X, Y, Z))) : -1.0f;
+    }
+}
+
+void ComputeVoxelSquaredDistancesBruteForce(const FIntVector& Dims, const TArray<bool>& Sites, TArray<float>& OutSquaredDistances)
+{
+    const int32 NumCells = Dims.X * Dims.Y * Dims.Z;
+    check(Sites.Num() == NumCells);
+
+    TArray<FIntVector> SiteCells;
+    for (int32 Z = 0; Z < Dims.Z; ++Z)
+    for (int32 Y = 0; Y < Dims.Y; ++Y)
+    for (int32 X = 0; X < Dims.X; ++X)
+    {
+        if (Sites[GetVoxelLinearIndex(Dims, X, Y, Z)]) { SiteCells.Add(FIntVector(X, Y, Z)); }
+    }
+
+    OutSquaredDistances.SetNumUninitialized(NumCells);
+    for (int32 Z = 0; Z < Dims.Z; ++Z)
+    for (int32 Y = 0; Y < Dims.Y; ++Y)
+    for (int32 X = 0; X < Dims.X; ++X)
+    {
+        int32 Best = MAX_int32;
+        for (const FIntVector& Site : SiteCells)
+        {
+            const FIntVector D = Site - FIntVector(X, Y, Z);
+            Best = FMath::Min(Best, D.X * D.X + D.Y * D.Y + D.Z * D.Z);
+        }
+        OutSquaredDistances[GetVoxelLinearIndex(Dims, X, Y, Z)] = SiteCells.Num() > 0 ? float(Best) : -1.0f;
+    }
+}
+
+// r.Voxel.ValidateJfa [Size] [NumSites] [Seed]
+static FAutoConsoleCommand GVoxelValidateJfaCmd(
+    TEXT("r.Voxel.ValidateJfa"),
+    TEXT("Measures the distance error of packed-seed jump flooding against the exact EDT on a random volume. Args: [Size=24] [NumSites=16] [Seed=1]"),
+    FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+    {
+        const int32 Size     = Args.Num() > 0 ? FMath::Clamp(FCString::Atoi(*Args[0]), 1, 128) : 24;
+        const int32 NumSites = Args.Num() > 1 ? FMath::Max(0, FCString::Atoi(*Args[1])) : 16;
+        const int32 Seed     = Args.Num() > 2 ? FCString::Atoi(*Args[2]) : 1;
+
+        const FIntVector Dims(Size, Size + 3, Size + 5);
+        FRandomStream Random(Seed);
+        TArray<bool> Sites;
+        Sites.SetNumZeroed(Dims.X * Dims.Y * Dims.Z);
+        for (int32 Index = 0; Index < NumSites; ++Index)
+        {
+            Sites[Random.RandHelper(Sites.Num())] = true;
+        }
+
+        TArray<float> Jfa, Exact;
+        ComputeVoxelSquaredJfa(Dims, Sites, Jfa);
+        ComputeVoxelSquaredEdt(Dims, Sites, Exact);
+
+        int32 NumMismatches = 0;
+        double MaxError = 0.0;
+        double SumError = 0.0;
+        for (int32 Index = 0; Index < Jfa.Num(); ++Index)
+        {
+            if (Jfa[Index] == Exact[Index]) continue;
+
+            // JFA never misses a site entirely when one exists, so both values are non-negative here
+            const double Error = FMath::Sqrt(double(Jfa[Index])) - FMath::Sqrt(double(Exact[Index]));
+            MaxError = FMath::Max(MaxError, Error);
+            SumError += Error;
+            ++NumMismatches;
+        }
+
+        UE_LOG(LogVoxelTest, Display, TEXT("Voxel JFA validation (%dx%dx%d, %d sites, seed %d): %d / %d cells above the exact distance, max error %.3f cells, mean error %.4f cells"),
+            Dims.X, Dims.Y, Dims.Z, NumSites, Seed, NumMismatches, Jfa.Num(), MaxError, NumMismatches > 0 ? SumError / NumMismatches : 0.0);
+    }));
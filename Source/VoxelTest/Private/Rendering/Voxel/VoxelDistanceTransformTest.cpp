@@ -0,0 +1,143 @@
+#include "Rendering/Voxel/VoxelDistanceTransform.h"
+#include "Rendering/Voxel/VoxelRenderPass.h"
+
+#include "Math/RandomStream.h"
+#include "Misc/App.h"
+#include "Misc/AutomationTest.h"
+#include "RenderingThread.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// Non-cubic to catch axis mixups; sites never share a face, so on the GPU each one is a surface cell seeded at its
+// own center and the distances match the cell-center reference
+static TArray<bool> MakeVoxelDistanceTransformSites(const FIntVector& Dims, int32 NumSites, int32 Seed)
+{
+    FRandomStream Random(Seed);
+    TArray<bool> Sites;
+    Sites.SetNumZeroed(Dims.X * Dims.Y * Dims.Z);
+
+    auto IsSite = [&](int32 X, int32 Y, int32 Z)
+    {
+        return X >= 0 && Y >= 0 && Z >= 0 && X < Dims.X && Y < Dims.Y && Z < Dims.Z
+            && Sites[X + Dims.X * (Y + Dims.Y * Z)];
+    };
+
+    for (int32 Index = 0; Index < NumSites; ++Index)
+    {
+        const int32 X = Random.RandHelper(Dims.X);
+        const int32 Y = Random.RandHelper(Dims.Y);
+        const int32 Z = Random.RandHelper(Dims.Z);
+        if (!IsSite(X - 1, Y, Z) && !IsSite(X + 1, Y, Z) && !IsSite(X, Y - 1, Z)
+            && !IsSite(X, Y + 1, Z) && !IsSite(X, Y, Z - 1) && !IsSite(X, Y, Z + 1))
+        {
+            Sites[X + Dims.X * (Y + Dims.Y * Z)] = true;
+        }
+    }
+    return Sites;
+}
+
+static TArray<float> ComputeVoxelSquaredDistancesGpuBlocking(const FIntVector& Dims, const TArray<bool>& Sites, bool bExactEdt, bool bPackedSeeds, bool bTiled)
+{
+    TArray<float> Distances;
+    ENQUEUE_RENDER_COMMAND(VoxelDistanceTransformTest)(
+        [&Dims, &Sites, &Distances, bExactEdt, bPackedSeeds, bTiled](FRHICommandListImmediate& RHICmdList)
+        {
+            ComputeVoxelSquaredDistancesGpu(RHICmdList, Dims, Sites, bExactEdt, bPackedSeeds, bTiled, Distances);
+        });
+    FlushRenderingCommands();
+    return Distances;
+}
+
+// Counts the cells whose squared distances differ by more than float rounding of the GPU's length()
+static int32 CountVoxelDistanceMismatches(const TArray<float>& Actual, const TArray<float>& Expected)
+{
+    if (Actual.Num() != Expected.Num())
+    {
+        return FMath::Max(Actual.Num(), Expected.Num());
+    }
+
+    int32 NumMismatches = 0;
+    for (int32 Index = 0; Index < Actual.Num(); ++Index)
+    {
+        if (FMath::Abs(Actual[Index] - Expected[Index]) > 1e-3f * FMath::Max(1.0f, Expected[Index]))
+        {
+            ++NumMismatches;
+        }
+    }
+    return NumMismatches;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FVoxelCpuEdtTest, "VoxelTest.Rendering.DistanceTransform.CpuEdtMatchesBruteForce",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FVoxelCpuEdtTest::RunTest(const FString& Parameters)
+{
+    const FIntVector Dims(24, 27, 29);
+    for (int32 Seed = 1; Seed <= 4; ++Seed)
+    {
+        const TArray<bool> Sites = MakeVoxelDistanceTransformSites(Dims, 16, Seed);
+        TArray<float> Exact, Reference;
+        ComputeVoxelSquaredEdt(Dims, Sites, Exact);
+        ComputeVoxelSquaredDistancesBruteForce(Dims, Sites, Reference);
+        TestEqual(FString::Printf(TEXT("Mismatching cells (seed %d)"), Seed), CountVoxelDistanceMismatches(Exact, Reference), 0);
+    }
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FVoxelGpuEdtTest, "VoxelTest.Rendering.DistanceTransform.GpuEdtMatchesCpu",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FVoxelGpuEdtTest::RunTest(const FString& Parameters)
+{
+    if (!FApp::CanEverRender())
+    {
+        AddInfo(TEXT("Skipped: no RHI to run the GPU distance transform on"));
+        return true;
+    }
+
+    const FIntVector Dims(24, 27, 29);
+    for (int32 Seed = 1; Seed <= 4; ++Seed)
+    {
+        const TArray<bool> Sites = MakeVoxelDistanceTransformSites(Dims, 16, Seed);
+        TArray<float> Reference;
+        ComputeVoxelSquaredEdt(Dims, Sites, Reference);
+
+        for (const bool bPackedSeeds : { false, true })
+        {
+            const TArray<float> Gpu = ComputeVoxelSquaredDistancesGpuBlocking(Dims, Sites, /*bExactEdt*/ true, bPackedSeeds, /*bTiled*/ true);
+            TestEqual(FString::Printf(TEXT("Mismatching cells (seed %d, packed seeds %d)"), Seed, bPackedSeeds), CountVoxelDistanceMismatches(Gpu, Reference), 0);
+        }
+    }
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FVoxelGpuJfaTest, "VoxelTest.Rendering.DistanceTransform.GpuJfaMatchesCpuMirror",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+// ComputeVoxelSquaredJfa claims to reproduce the packed GPU seed field exactly, with and without the groupshared
+// tiled steps; any divergence in schedule, tap order or tie-breaking shows up as a cell with a different distance
+bool FVoxelGpuJfaTest::RunTest(const FString& Parameters)
+{
+    if (!FApp::CanEverRender())
+    {
+        AddInfo(TEXT("Skipped: no RHI to run the GPU distance transform on"));
+        return true;
+    }
+
+    const FIntVector Dims(24, 27, 29);
+    for (int32 Seed = 1; Seed <= 4; ++Seed)
+    {
+        const TArray<bool> Sites = MakeVoxelDistanceTransformSites(Dims, 16, Seed);
+        TArray<float> Reference;
+        ComputeVoxelSquaredJfa(Dims, Sites, Reference);
+
+        for (const bool bTiled : { false, true })
+        {
+            const TArray<float> Gpu = ComputeVoxelSquaredDistancesGpuBlocking(Dims, Sites, /*bExactEdt*/ false, /*bPackedSeeds*/ true, bTiled);
+            TestEqual(FString::Printf(TEXT("Mismatching cells (seed %d, tiled %d)"), Seed, bTiled), CountVoxelDistanceMismatches(Gpu, Reference), 0);
+        }
+    }
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
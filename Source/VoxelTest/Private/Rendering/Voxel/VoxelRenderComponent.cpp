@@ -43,7 +43,7 @@ void UVoxelRenderComponent::RebuildFromExtent()
         return;
     }
     const FVector RegionSize = Extent;
-    VolumeAsset->BuildVoxelGrid(RegionSize, FMath::Max(1.0f, BlockSize));
+    VolumeAsset->BuildVoxelGrid(RegionSize, FMath::Max(1.0f, BlockSize), /*bForceRebuild*/ true);
     MarkRenderStateDirty();
 }
 
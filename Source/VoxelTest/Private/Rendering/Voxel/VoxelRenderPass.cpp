@@ -3,6 +3,7 @@
 #include "CommonRenderResources.h"
 #include "Rendering/Voxel/VoxelSceneProxy.h"
 #include "Rendering/Voxel/VoxelRenderResources.h"
+#include "Rendering/Voxel/VoxelDistanceTransform.h"
 
 #include "GlobalShader.h"
 #include "ShaderParameterStruct.h"
@@ -12,11 +13,26 @@
 #include "RHIResources.h"
 #include "RHI.h"
 #include "SceneView.h"
+#include "SceneManagement.h"
 #include "RendererInterface.h"
 #include "RenderGraphBuilder.h"
 #include "HAL/IConsoleManager.h"
 #include "Math/IntVector.h"
 #include "Logging/LogMacros.h"
+#include "Stats/Stats.h"
+
+DECLARE_STATS_GROUP(TEXT("Voxel"), STATGROUP_Voxel, STATCAT_Advanced);
+DECLARE_DWORD_COUNTER_STAT(TEXT("SDF Cache Hits"), STAT_VoxelSdfCacheHits, STATGROUP_Voxel);
+DECLARE_DWORD_COUNTER_STAT(TEXT("SDF Rebuilds"),   STAT_VoxelSdfRebuilds,  STATGROUP_Voxel);
+DECLARE_DWORD_COUNTER_STAT(TEXT("SDF Rebuilds (Warm Start)"), STAT_VoxelSdfWarmRebuilds, STATGROUP_Voxel);
+DECLARE_DWORD_COUNTER_STAT(TEXT("SDF Rebuilds (Region)"), STAT_VoxelSdfRegionRebuilds, STATGROUP_Voxel);
+DECLARE_DWORD_COUNTER_STAT(TEXT("SDF Builds Shared"), STAT_VoxelSdfSharedBuilds, STATGROUP_Voxel);
+DECLARE_DWORD_COUNTER_STAT(TEXT("SDF Rebuilds Deferred"), STAT_VoxelSdfRebuildsDeferred, STATGROUP_Voxel);
+
+DECLARE_GPU_STAT_NAMED(VoxelDistanceTransformJFA, TEXT("Voxel Distance Transform (JFA)"));
+DECLARE_GPU_STAT_NAMED(VoxelDistanceTransformEDT, TEXT("Voxel Distance Transform (EDT)"));
+DECLARE_GPU_STAT_NAMED(VoxelSeed,                 TEXT("Voxel Seed"));
+DECLARE_GPU_STAT_NAMED(VoxelJfaSmallSteps,        TEXT("Voxel JFA Small Steps"));
 
 static TAutoConsoleVariable<int32> CVarVoxelDebug(
     TEXT("r.Voxel.Debug"),
@@ -57,7 +73,14 @@ END_SHADER_PARAMETER_STRUCT()
 // Raymarch pass parameters - includes all textures for proper RDG resource transitions
 BEGIN_SHADER_PARAMETER_STRUCT(FVoxelRaymarchPassParameters, )
     SHADER_PARAMETER_RDG_TEXTURE(Texture3D<float>, SDFTex)
-    SHADER_PARAMETER_RDG_TEXTURE(Texture3D<uint>, DensityTex)
+    SHADER_PARAMETER_RDG_TEXTURE(Texture3D<float>, SdfMinTex)
+    SHADER_PARAMETER_RDG_TEXTURE(Texture3D<uint>, SdfIndirectionTex)
+    SHADER_PARAMETER_RDG_TEXTURE(Texture3D<float>, SdfAtlasTex)
+    SHADER_PARAMETER_RDG_TEXTURE(Texture3D<float>, DensityTex)
+    SHADER_PARAMETER_RDG_TEXTURE(Texture3D<float2>, NormalTex)
+    SHADER_PARAMETER_RDG_TEXTURE(Texture2D<float>, SceneDepthTex)
+    SHADER_PARAMETER_RDG_TEXTURE(Texture2D<uint>, TemporalStartTex)
+    SHADER_PARAMETER_RDG_TEXTURE(Texture2DArray<float>, ConeStartTex)
     RENDER_TARGET_BINDING_SLOTS()
 END_SHADER_PARAMETER_STRUCT()
 
@@ -84,7 +107,224 @@ static TAutoConsoleVariable<int32> CVarVoxelRaymarch(
     TEXT("Enable voxel raymarch render pass (0=off, 1=on)"),
     ECVF_Default);
 
-static constexpr float GVoxelOverlapMultiplier = 2.0f;
+static TAutoConsoleVariable<int32> CVarVoxelRaymarchBatched(
+    TEXT("r.Voxel.Raymarch.Batched"),
+    0,
+    TEXT("Raymarch up to 8 dense-SDF volumes per pass with near-to-far traversal (0=one pass per volume, 1=batched)"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarVoxelRaymarchResolutionDivisor(
+    TEXT("r.Voxel.Raymarch.ResolutionDivisor"),
+    1,
+    TEXT("Raymarch at 1/N resolution followed by a depth-aware upsample into SceneColor/SceneDepth (1=full, 2=half, 4=quarter)"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarVoxelRaymarchEmptySpaceSkip(
+    TEXT("r.Voxel.Raymarch.EmptySpaceSkip"),
+    1,
+    TEXT("Skip whole 8^3 SDF blocks whose minimum distance proves they contain no surface (0=off, 1=on)"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarVoxelRaymarchDebugSteps(
+    TEXT("r.Voxel.Raymarch.DebugSteps"),
+    0,
+    TEXT("Output a per-pixel raymarch step count heat map instead of shading (0=off, 1=on)"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarVoxelRaymarchMaxSteps(
+    TEXT("r.Voxel.Raymarch.MaxSteps"),
+    192,
+    TEXT("Sphere-tracing step budget per volume, compiled into the raymarch shaders (64, 128 or 192; smaller budgets take larger steps and halve the hit refinement bisection steps)"),
+    ECVF_Scalability | ECVF_RenderThreadSafe);
+
+static TAutoConsoleVariable<int32> CVarVoxelRaymarchNormalMethod(
+    TEXT("r.Voxel.Raymarch.NormalMethod"),
+    0,
+    TEXT("Density gradient used for shading normals (0=6-tap central difference, 1=4-tap tetrahedral, 2=precomputed octahedral normal volume)"),
+    ECVF_Scalability | ECVF_RenderThreadSafe);
+
+static TAutoConsoleVariable<int32> CVarVoxelRaymarchConePrepass(
+    TEXT("r.Voxel.Raymarch.ConePrepass"),
+    1,
+    TEXT("March one conservative cone per screen tile before the raymarch and start every ray of the tile there (0=off, 1=on)"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarVoxelRaymarchConePrepassTileSize(
+    TEXT("r.Voxel.Raymarch.ConePrepass.TileSize"),
+    8,
+    TEXT("Cone prepass tile size in raymarch pixels (8 or 16)"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarVoxelRaymarchTemporalStart(
+    TEXT("r.Voxel.Raymarch.TemporalStart"),
+    1,
+    TEXT("Start rays shortly before last frame's reprojected hit instead of at the volume entry (0=off, 1=on)"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarVoxelRaymarchTemporalStartMargin(
+    TEXT("r.Voxel.Raymarch.TemporalStart.Margin"),
+    2.0f,
+    TEXT("Distance in voxels that a reprojected ray start is pulled back toward the camera"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarVoxelSdfNarrowBand(
+    TEXT("r.Voxel.SdfNarrowBand"),
+    0,
+    TEXT("Store the SDF as a narrow-band brick atlas with an indirection volume (0=dense, 1=narrow band). Only the SDF is sparse: the resolved R16F density volume (2 bytes per cell) and, with r.Voxel.Raymarch.NormalMethod=2, the G16R16 normal volume (4 bytes per cell) stay dense for shading"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarVoxelSdfNarrowBandWidth(
+    TEXT("r.Voxel.SdfNarrowBand.Width"),
+    2.0f,
+    TEXT("Narrow band half width in voxels; bricks farther from the surface are stored as constants"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarVoxelSdfNarrowBandTileSize(
+    TEXT("r.Voxel.SdfNarrowBand.TileSize"),
+    128,
+    TEXT("Narrow-band SDFs are built in tiles of this many cells per axis (rounded up to whole 8^3 bricks), so no volume-sized SDF, seed field or splat accumulation is allocated (0=whole volume at once)"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarVoxelSdfNarrowBandTileMargin(
+    TEXT("r.Voxel.SdfNarrowBand.TileMargin"),
+    16,
+    TEXT("Cells of context around each narrow-band tile; distances of constant bricks are capped at this many voxels (at least the band width + 1)"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarVoxelDistanceTransform(
+    TEXT("r.Voxel.DistanceTransform"),
+    0,
+    TEXT("Distance transform used to propagate surface seeds (0=jump flooding, 1=exact separable EDT; falls back to JFA above the EDT line limit)"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarVoxelDistanceTransformPackedSeeds(
+    TEXT("r.Voxel.DistanceTransform.PackedSeeds"),
+    0,
+    TEXT("Propagate seeds as packed 32-bit surface cell indices instead of RGBA32F sub-voxel positions (0=off, 1=on; volumes up to 1024 cells per axis)"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarVoxelDistanceTransformTiled(
+    TEXT("r.Voxel.DistanceTransform.Tiled"),
+    1,
+    TEXT("Run the seed pass and the JFA steps up to 4 (up to 2 with RGBA32F seeds) from groupshared tiles (0=off, 1=on). Both produce identical results"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarVoxelDistanceTransformWarmStart(
+    TEXT("r.Voxel.DistanceTransform.WarmStart"),
+    0,
+    TEXT("JFA rebuilds start from the previous build's seed field and only run steps 4, 2, 1, with distances capped at their 7 cell reach (0=off, 1=on; needs r.Voxel.DistanceTransform.PackedSeeds)"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarVoxelDistanceTransformWarmStartFullRebuildInterval(
+    TEXT("r.Voxel.DistanceTransform.WarmStart.FullRebuildInterval"),
+    16,
+    TEXT("Warm-started rebuilds in a row before a full JFA rebuild resets the drift of carried-over seeds"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarVoxelSplatMode(
+    TEXT("r.Voxel.SplatMode"),
+    0,
+    TEXT("Density splat kernel (0=one thread per instance, 1=one cooperative group per instance, 2=one thread per instance with groupshared accumulation). All produce identical density; 1 compacts the occupied instances first and dispatches its groups indirectly over them, which pays off for large instances"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarVoxelRebuildBudget(
+    TEXT("r.Voxel.RebuildBudget"),
+    0,
+    TEXT("SDF rebuild work per frame in voxels (0=unlimited). Dirty volumes over budget keep their previous SDF on screen and are rebuilt on later frames, largest on screen first; at least one volume is rebuilt every frame"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarVoxelRegionUpdate(
+    TEXT("r.Voxel.RegionUpdate"),
+    1,
+    TEXT("Rebuild the dense SDF only around the dirty box of local edits such as UVoxelVolume::CarveSpheres (0=always rebuild the whole volume, 1=on)"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarVoxelRegionUpdateMargin(
+    TEXT("r.Voxel.RegionUpdate.Margin"),
+    8,
+    TEXT("Cells around the dirty box whose distances are rewritten by a region update; distances beyond it keep their previous value"),
+    ECVF_Default);
+
+// Fixed texture slots per batched raymarch pass (VOXEL_BATCH_SWITCH in VoxelRaymarch.usf)
+static constexpr int32 GVoxelBatchMaxVolumes = 8;
+
+// Longest line the EDT envelope can hold in groupshared memory
+static constexpr int32 GVoxelEdtMaxLine = 512;
+
+// First step of a warm-started JFA schedule (4, 2, 1)
+static constexpr int32 GVoxelJfaWarmStartStep = 4;
+
+enum class EVoxelDistanceTransform : uint8
+{
+    JumpFlood,
+    ExactEdt,
+};
+
+// SDF bricks are stored with a one voxel apron so hardware trilinear filtering stays inside the brick
+static constexpr int32 GVoxelSdfBrickSize       = FVoxelBrickMap::BrickSize;
+static constexpr int32 GVoxelSdfBrickStored     = GVoxelSdfBrickSize + 2;
+static constexpr int32 GVoxelSdfAtlasBricksXY   = 16;
+static constexpr int32 GVoxelSdfMinBrickCapacity = 64;
+
+// Everything read from cvars that changes the contents or layout of the cached volumes
+struct FVoxelSdfBuildSettings
+{
+    bool  bNarrowBand     = false;
+    float NarrowBandWidth = 2.0f;
+    EVoxelDistanceTransform DistanceTransform = EVoxelDistanceTransform::JumpFlood;
+    bool  bNormalVolume   = false;
+    bool  bPackedSeeds    = false;
+    bool  bWarmStart      = false;
+
+    static FVoxelSdfBuildSettings Get()
+    {
+        FVoxelSdfBuildSettings Settings;
+        Settings.bNarrowBand       = CVarVoxelSdfNarrowBand.GetValueOnAnyThread() != 0;
+        Settings.NarrowBandWidth   = FMath::Max(0.0f, CVarVoxelSdfNarrowBandWidth.GetValueOnAnyThread());
+        Settings.DistanceTransform = CVarVoxelDistanceTransform.GetValueOnAnyThread() == 1 ? EVoxelDistanceTransform::ExactEdt : EVoxelDistanceTransform::JumpFlood;
+        Settings.bNormalVolume     = CVarVoxelRaymarchNormalMethod.GetValueOnAnyThread() == 2;
+        Settings.bPackedSeeds      = CVarVoxelDistanceTransformPackedSeeds.GetValueOnAnyThread() != 0;
+        Settings.bWarmStart        = CVarVoxelDistanceTransformWarmStart.GetValueOnAnyThread() != 0;
+        return Settings;
+    }
+
+    uint32 GetKey() const
+    {
+        uint32 Key = GetTypeHash(bNarrowBand);
+        Key = HashCombine(Key, GetTypeHash(NarrowBandWidth));
+        Key = HashCombine(Key, GetTypeHash(static_cast<uint8>(DistanceTransform)));
+        Key = HashCombine(Key, GetTypeHash(bNormalVolume));
+        Key = HashCombine(Key, GetTypeHash(bPackedSeeds));
+        Key = HashCombine(Key, GetTypeHash(bWarmStart));
+        return Key;
+    }
+};
+
+// Compile-time quality of the raymarch pixel shaders, selected from the scalability cvars above
+class FVoxelRaymarchMaxStepsDim     : SHADER_PERMUTATION_SPARSE_INT("VOXEL_RAYMARCH_MAX_STEPS", 64, 128, 192);
+class FVoxelRaymarchNormalMethodDim : SHADER_PERMUTATION_INT("VOXEL_RAYMARCH_NORMAL_METHOD", 3);
+
+struct FVoxelRaymarchQuality
+{
+    int32 MaxSteps     = 192;
+    int32 NormalMethod = 0;   // 0 = central difference, 1 = tetrahedral, 2 = normal volume
+
+    static FVoxelRaymarchQuality Get()
+    {
+        const int32 Steps = CVarVoxelRaymarchMaxSteps.GetValueOnAnyThread();
+        FVoxelRaymarchQuality Quality;
+        Quality.MaxSteps     = Steps <= 64 ? 64 : (Steps <= 128 ? 128 : 192);
+        Quality.NormalMethod = FMath::Clamp(CVarVoxelRaymarchNormalMethod.GetValueOnAnyThread(), 0, 2);
+        return Quality;
+    }
+
+    template<typename PermutationDomainType>
+    void SetPermutation(PermutationDomainType& PermutationVector) const
+    {
+        PermutationVector.template Set<FVoxelRaymarchMaxStepsDim>(MaxSteps);
+        PermutationVector.template Set<FVoxelRaymarchNormalMethodDim>(NormalMethod);
+    }
+};
 
 class FSplatInstancesCS : public FGlobalShader
 {
@@ -92,29 +332,117 @@ public:
     DECLARE_GLOBAL_SHADER(FSplatInstancesCS);
     SHADER_USE_PARAMETER_STRUCT(FSplatInstancesCS, FGlobalShader);
 
+    class FCooperativeDim : SHADER_PERMUTATION_BOOL("SPLAT_COOPERATIVE");
+    class FTiledDim       : SHADER_PERMUTATION_BOOL("SPLAT_TILED");
+    using FPermutationDomain = TShaderPermutationDomain<FCooperativeDim, FTiledDim>;
+
+    static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
+    {
+        const FPermutationDomain PermutationVector(Parameters.PermutationId);
+        return !(PermutationVector.Get<FCooperativeDim>() && PermutationVector.Get<FTiledDim>());
+    }
+
     BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
         SHADER_PARAMETER(uint32, NumInstances)
+        SHADER_PARAMETER(uint32, DispatchGroupsX)
         SHADER_PARAMETER(FVector3f, VolumeMinLS)
         SHADER_PARAMETER(float, VoxelSizeLS)
         SHADER_PARAMETER(FIntVector, VolumeDimensions)
-        SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<float4>, InstanceCenters)
+        SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<float3>, InstanceCenters)
         SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<float>,  InstanceScales)
+        SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<int4>,   BrickCoords)
+        SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<uint>,   SplatSlots)
+        SHADER_PARAMETER(uint32, NumSplatSlots)
+        SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<uint>,   SplatList)
+        SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<uint>,   SplatListCount)
         SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture3D<uint>, DensityUAV)
         SHADER_PARAMETER(float, BaseEdgeLengthLS)
         SHADER_PARAMETER(float, OverlapMultiplier)
+        RDG_BUFFER_ACCESS(IndirectArgs, ERHIAccess::IndirectArgs)
+    END_SHADER_PARAMETER_STRUCT()
+
+    static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment)
+    {
+        FGlobalShader::ModifyCompilationEnvironment(Parameters, OutEnvironment);
+        OutEnvironment.SetDefine(TEXT("BRICK_CELL_SHIFT"), 3 * FVoxelBrickMap::BrickShift);
+    }
+};
+
+// Cooperative splat prepass: lists the occupied atlas cells whose footprint reaches the volume
+class FCompactSplatInstancesCS : public FGlobalShader
+{
+public:
+    DECLARE_GLOBAL_SHADER(FCompactSplatInstancesCS);
+    SHADER_USE_PARAMETER_STRUCT(FCompactSplatInstancesCS, FGlobalShader);
+
+    BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+        SHADER_PARAMETER(uint32, NumInstances)
+        SHADER_PARAMETER(uint32, DispatchGroupsX)
+        SHADER_PARAMETER(FVector3f, VolumeMinLS)
+        SHADER_PARAMETER(float, VoxelSizeLS)
+        SHADER_PARAMETER(FIntVector, VolumeDimensions)
+        SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<float3>, InstanceCenters)
+        SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<float>,  InstanceScales)
+        SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<int4>,   BrickCoords)
+        SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<uint>,   SplatSlots)
+        SHADER_PARAMETER(uint32, NumSplatSlots)
+        SHADER_PARAMETER(float, BaseEdgeLengthLS)
+        SHADER_PARAMETER(float, OverlapMultiplier)
+        SHADER_PARAMETER_RDG_BUFFER_UAV(RWStructuredBuffer<uint>, SplatListUAV)
+        SHADER_PARAMETER_RDG_BUFFER_UAV(RWStructuredBuffer<uint>, SplatListCountUAV)
+    END_SHADER_PARAMETER_STRUCT()
+
+    static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment)
+    {
+        FGlobalShader::ModifyCompilationEnvironment(Parameters, OutEnvironment);
+        OutEnvironment.SetDefine(TEXT("BRICK_CELL_SHIFT"), 3 * FVoxelBrickMap::BrickShift);
+    }
+};
+
+// Turns the compacted list length into the cooperative splat's wrapped dispatch
+class FSplatIndirectArgsCS : public FGlobalShader
+{
+public:
+    DECLARE_GLOBAL_SHADER(FSplatIndirectArgsCS);
+    SHADER_USE_PARAMETER_STRUCT(FSplatIndirectArgsCS, FGlobalShader);
+
+    BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+        SHADER_PARAMETER(uint32, DispatchGroupsX)
+        SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<uint>, SplatListCount)
+        SHADER_PARAMETER_RDG_BUFFER_UAV(RWBuffer<uint>, SplatIndirectArgsUAV)
     END_SHADER_PARAMETER_STRUCT()
+
+    static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment)
+    {
+        FGlobalShader::ModifyCompilationEnvironment(Parameters, OutEnvironment);
+        OutEnvironment.SetDefine(TEXT("BRICK_CELL_SHIFT"), 3 * FVoxelBrickMap::BrickShift);
+    }
 };
 
+// Seed texture layout shared by the seed and propagation passes (see VoxelDistanceField.usf)
+class FVoxelSeedPackedDim : SHADER_PERMUTATION_BOOL("VOXEL_SEED_PACKED");
+// Last propagation pass writes the signed distance straight into the SDF instead of the seed texture
+class FVoxelWriteSdfDim   : SHADER_PERMUTATION_BOOL("DT_WRITE_SDF");
+// ... of a region rebuild: writes the update box of the sub-volume, merged with the previous distances
+class FVoxelRegionDim     : SHADER_PERMUTATION_BOOL("DT_REGION");
+
 class FSeedCS : public FGlobalShader
 {
 public:
     DECLARE_GLOBAL_SHADER(FSeedCS);
     SHADER_USE_PARAMETER_STRUCT(FSeedCS, FGlobalShader);
 
+    class FTiledDim : SHADER_PERMUTATION_BOOL("SEED_TILED");
+    // Falls back to the previous build's seeds (InSeed) off the current surface, for a warm-started JFA schedule
+    class FWarmDim  : SHADER_PERMUTATION_BOOL("SEED_WARM");
+    using FPermutationDomain = TShaderPermutationDomain<FVoxelSeedPackedDim, FTiledDim, FWarmDim>;
+
     BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
         SHADER_PARAMETER(FIntVector, VolumeDimensions)
         SHADER_PARAMETER(float, VoxelSizeLS)
+        SHADER_PARAMETER(int32, Step)
         SHADER_PARAMETER_RDG_TEXTURE(Texture3D<uint>, DensityTex)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture3D<float4>, InSeed)
         SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture3D<float4>, SeedUAV)
     END_SHADER_PARAMETER_STRUCT()
 };
@@ -125,39 +453,175 @@ public:
     DECLARE_GLOBAL_SHADER(FJFACS);
     SHADER_USE_PARAMETER_STRUCT(FJFACS, FGlobalShader);
 
+    // Non-zero: the step (equal to this value) reads its neighbourhood from a groupshared tile
+    class FTileStepDim  : SHADER_PERMUTATION_SPARSE_INT("JFA_TILE_STEP", 0, 1, 2, 4);
+    // Last step also stores its seeds for the next warm start
+    class FKeepSeedDim  : SHADER_PERMUTATION_BOOL("JFA_KEEP_SEED");
+    using FPermutationDomain = TShaderPermutationDomain<FVoxelSeedPackedDim, FVoxelWriteSdfDim, FTileStepDim, FKeepSeedDim, FVoxelRegionDim>;
+
+    static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
+    {
+        const FPermutationDomain PermutationVector(Parameters.PermutationId);
+        if ((PermutationVector.Get<FKeepSeedDim>() && !PermutationVector.Get<FVoxelWriteSdfDim>())
+            || (PermutationVector.Get<FVoxelRegionDim>() && !PermutationVector.Get<FVoxelWriteSdfDim>()))
+        {
+            return false;
+        }
+        return PermutationVector.Get<FTileStepDim>() <= GetMaxTileStep(PermutationVector.Get<FVoxelSeedPackedDim>());
+    }
+
+    // Largest tiled step whose (8 + 2 * Step)^3 seed tile fits in 32KB of groupshared memory
+    static int32 GetMaxTileStep(bool bPackedSeeds)
+    {
+        return bPackedSeeds ? 4 : 2;
+    }
+
     BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
         SHADER_PARAMETER(FIntVector, VolumeDimensions)
+        SHADER_PARAMETER(FVector3f, VolumeMinLS)
+        SHADER_PARAMETER(float, VoxelSizeLS)
         SHADER_PARAMETER(int32, Step)
+        SHADER_PARAMETER(FIntVector, RegionOrigin)
+        SHADER_PARAMETER(FIntVector, UpdateMin)
+        SHADER_PARAMETER(FIntVector, UpdateMax)
+        SHADER_PARAMETER(float, RegionMarginLS)
+        SHADER_PARAMETER(float, WarmReachLS)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture3D<uint>, DensityTex)
         SHADER_PARAMETER_RDG_TEXTURE(Texture3D<float4>, InSeed)
         SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture3D<float4>, OutSeed)
+        SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture3D<float>, SdfUAV)
     END_SHADER_PARAMETER_STRUCT()
 };
 
-class FDistanceToSdfCS : public FGlobalShader
+class FEdtCS : public FGlobalShader
 {
 public:
-    DECLARE_GLOBAL_SHADER(FDistanceToSdfCS);
-    SHADER_USE_PARAMETER_STRUCT(FDistanceToSdfCS, FGlobalShader);
+    DECLARE_GLOBAL_SHADER(FEdtCS);
+    SHADER_USE_PARAMETER_STRUCT(FEdtCS, FGlobalShader);
+
+    using FPermutationDomain = TShaderPermutationDomain<FVoxelSeedPackedDim, FVoxelWriteSdfDim, FVoxelRegionDim>;
+
+    static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
+    {
+        const FPermutationDomain PermutationVector(Parameters.PermutationId);
+        return !PermutationVector.Get<FVoxelRegionDim>() || PermutationVector.Get<FVoxelWriteSdfDim>();
+    }
 
     BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
         SHADER_PARAMETER(FIntVector, VolumeDimensions)
         SHADER_PARAMETER(FVector3f, VolumeMinLS)
         SHADER_PARAMETER(float, VoxelSizeLS)
-        SHADER_PARAMETER_RDG_TEXTURE(Texture3D<float4>, SeedTex)
+        SHADER_PARAMETER(int32, LineAxis)
+        SHADER_PARAMETER(FIntVector, RegionOrigin)
+        SHADER_PARAMETER(FIntVector, UpdateMin)
+        SHADER_PARAMETER(FIntVector, UpdateMax)
+        SHADER_PARAMETER(float, RegionMarginLS)
+        SHADER_PARAMETER(float, WarmReachLS)
         SHADER_PARAMETER_RDG_TEXTURE(Texture3D<uint>, DensityTex)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture3D<float4>, InSeed)
+        SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture3D<float4>, OutSeed)
         SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture3D<float>, SdfUAV)
     END_SHADER_PARAMETER_STRUCT()
+
+    static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment)
+    {
+        FGlobalShader::ModifyCompilationEnvironment(Parameters, OutEnvironment);
+        OutEnvironment.SetDefine(TEXT("EDT_MAX_LINE"), GVoxelEdtMaxLine);
+    }
+};
+
+class FSdfBrickBuildCS : public FGlobalShader
+{
+public:
+    DECLARE_GLOBAL_SHADER(FSdfBrickBuildCS);
+    SHADER_USE_PARAMETER_STRUCT(FSdfBrickBuildCS, FGlobalShader);
+
+    BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+        SHADER_PARAMETER(FIntVector, VolumeDimensions)
+        SHADER_PARAMETER(FIntVector, SdfAtlasBricks)
+        SHADER_PARAMETER(uint32, SdfBrickCapacity)
+        SHADER_PARAMETER(float, NarrowBandLS)
+        SHADER_PARAMETER(FIntVector, BrickOffset)
+        SHADER_PARAMETER(FIntVector, DenseSdfOrigin)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture3D<float>, DenseSdfTex)
+        SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture3D<uint>, SdfIndirectionUAV)
+        SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture3D<float>, SdfAtlasUAV)
+        SHADER_PARAMETER_RDG_BUFFER_UAV(RWStructuredBuffer<uint>, SdfBrickCounterUAV)
+    END_SHADER_PARAMETER_STRUCT()
+};
+
+class FSdfMinReduceCS : public FGlobalShader
+{
+public:
+    DECLARE_GLOBAL_SHADER(FSdfMinReduceCS);
+    SHADER_USE_PARAMETER_STRUCT(FSdfMinReduceCS, FGlobalShader);
+
+    BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+        SHADER_PARAMETER(FIntVector, VolumeDimensions)
+        SHADER_PARAMETER(FIntVector, BrickOffset)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture3D<float>, DenseSdfTex)
+        SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture3D<float>, SdfMinUAV)
+    END_SHADER_PARAMETER_STRUCT()
+};
+
+class FNormalVolumeBuildCS : public FGlobalShader
+{
+public:
+    DECLARE_GLOBAL_SHADER(FNormalVolumeBuildCS);
+    SHADER_USE_PARAMETER_STRUCT(FNormalVolumeBuildCS, FGlobalShader);
+
+    BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+        SHADER_PARAMETER(FIntVector, VolumeDimensions)
+        SHADER_PARAMETER(FIntVector, RegionOrigin)
+        SHADER_PARAMETER(FIntVector, UpdateMin)
+        SHADER_PARAMETER(FIntVector, UpdateMax)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture3D<uint>, DensityTex)
+        SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture3D<float2>, NormalUAV)
+    END_SHADER_PARAMETER_STRUCT()
+};
+
+class FDensityResolveCS : public FGlobalShader
+{
+public:
+    DECLARE_GLOBAL_SHADER(FDensityResolveCS);
+    SHADER_USE_PARAMETER_STRUCT(FDensityResolveCS, FGlobalShader);
+
+    BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+        SHADER_PARAMETER(FIntVector, VolumeDimensions)
+        SHADER_PARAMETER(FIntVector, RegionOrigin)
+        SHADER_PARAMETER(FIntVector, UpdateMin)
+        SHADER_PARAMETER(FIntVector, UpdateMax)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture3D<uint>, DensityTex)
+        SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture3D<float>, DensityResolvedUAV)
+    END_SHADER_PARAMETER_STRUCT()
+};
+
+class FSdfReadbackCS : public FGlobalShader
+{
+public:
+    DECLARE_GLOBAL_SHADER(FSdfReadbackCS);
+    SHADER_USE_PARAMETER_STRUCT(FSdfReadbackCS, FGlobalShader);
+
+    BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+        SHADER_PARAMETER(FIntVector, VolumeDimensions)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture3D<float>, DenseSdfTex)
+        SHADER_PARAMETER_RDG_BUFFER_UAV(RWStructuredBuffer<float>, SdfReadbackUAV)
+    END_SHADER_PARAMETER_STRUCT()
 };
 
 // ========= Raymarch pixel shader =========
 
-class FRaymarchFullscreenVS : public FGlobalShader
+class FRaymarchBoundingBoxVS : public FGlobalShader
 {
 public:
-    DECLARE_GLOBAL_SHADER(FRaymarchFullscreenVS);
-    SHADER_USE_PARAMETER_STRUCT(FRaymarchFullscreenVS, FGlobalShader);
+    DECLARE_GLOBAL_SHADER(FRaymarchBoundingBoxVS);
+    SHADER_USE_PARAMETER_STRUCT(FRaymarchBoundingBoxVS, FGlobalShader);
 
     BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+        SHADER_PARAMETER(FVector3f, VolumeMinLS)
+        SHADER_PARAMETER(FVector3f, VolumeMaxLS)
+        SHADER_PARAMETER(FMatrix44f, LocalToClip)
+        SHADER_PARAMETER(FVector3f, CameraPosLS)
     END_SHADER_PARAMETER_STRUCT()
 };
 
@@ -167,183 +631,1953 @@ public:
     DECLARE_GLOBAL_SHADER(FRaymarchPS);
     SHADER_USE_PARAMETER_STRUCT(FRaymarchPS, FGlobalShader);
 
+    class FNarrowBandDim : SHADER_PERMUTATION_BOOL("VOXEL_SDF_NARROW_BAND");
+    class FTemporalStartDim : SHADER_PERMUTATION_BOOL("VOXEL_RAYMARCH_TEMPORAL_START");
+    class FConeStartDim : SHADER_PERMUTATION_BOOL("VOXEL_RAYMARCH_CONE_START");
+    using FPermutationDomain = TShaderPermutationDomain<FNarrowBandDim, FTemporalStartDim, FConeStartDim,
+        FVoxelRaymarchMaxStepsDim, FVoxelRaymarchNormalMethodDim>;
+
     BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
         SHADER_PARAMETER(FVector3f, VolumeMinLS)
         SHADER_PARAMETER(FVector3f, VolumeMaxLS)
         SHADER_PARAMETER(float, VoxelSizeLS)
         SHADER_PARAMETER(FMatrix44f, LocalToWorld)
         SHADER_PARAMETER(FMatrix44f, WorldToLocal)
-        SHADER_PARAMETER(FMatrix44f, InvViewProj)
         SHADER_PARAMETER(FMatrix44f, ViewProj)
+        SHADER_PARAMETER(FMatrix44f, InvViewProj)
         SHADER_PARAMETER(FVector3f, CameraWorldPos)
+        SHADER_PARAMETER(FVector3f, CameraPosLS)
         SHADER_PARAMETER(FVector2f, ViewportInvSize)
-        SHADER_PARAMETER(FVector2f, ViewportMin)
         SHADER_PARAMETER(FIntVector, VolumeDims)
+        SHADER_PARAMETER(FIntVector, SdfAtlasBricks)
+        SHADER_PARAMETER(FVector3f, SdfAtlasInvSize)
+        SHADER_PARAMETER(int32, EmptySpaceSkip)
+        SHADER_PARAMETER(int32, DebugStepCount)
+        SHADER_PARAMETER(uint32, HistorySlot)
+        SHADER_PARAMETER(float, TemporalStartMargin)
+        SHADER_PARAMETER(uint32, ConeSlice)
+        SHADER_PARAMETER(int32, ConeTileSize)
         SHADER_PARAMETER_RDG_TEXTURE(Texture3D<float>, SDFTex)
-        SHADER_PARAMETER_RDG_TEXTURE(Texture3D<uint>, DensityTex)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture3D<float>, SdfMinTex)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture3D<uint>, SdfIndirectionTex)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture3D<float>, SdfAtlasTex)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture3D<float>, DensityTex)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture3D<float2>, NormalTex)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture2D<float>, SceneDepthTex)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture2D<uint>, TemporalStartTex)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture2DArray<float>, ConeStartTex)
         SHADER_PARAMETER_SAMPLER(SamplerState, SDFSampler)
     END_SHADER_PARAMETER_STRUCT()
 };
 
-// ComputeShaders
-IMPLEMENT_GLOBAL_SHADER(FSplatInstancesCS, "/Voxel/VoxelDensity.usf",       "SplatInstancesCS", SF_Compute);
-IMPLEMENT_GLOBAL_SHADER(FSeedCS,           "/Voxel/VoxelDistanceField.usf", "SeedCS",           SF_Compute);
-IMPLEMENT_GLOBAL_SHADER(FJFACS,            "/Voxel/VoxelDistanceField.usf", "JfaCS",            SF_Compute);
-IMPLEMENT_GLOBAL_SHADER(FDistanceToSdfCS,  "/Voxel/VoxelDistanceField.usf", "DistanceToSdfCS",  SF_Compute);
-
-// RaymarchShaders
-IMPLEMENT_GLOBAL_SHADER(FRaymarchFullscreenVS,  "/Voxel/VoxelRaymarch.usf", "FullscreenVS",     SF_Vertex);
-IMPLEMENT_GLOBAL_SHADER(FRaymarchPS,            "/Voxel/VoxelRaymarch.usf", "RaymarchPS",       SF_Pixel);
-
-static FIntVector DivideCeil3D(const FIntVector& VolumeDimensions, int32 GroupSize)
+class FRaymarchConePrepassCS : public FGlobalShader
 {
-    auto CeilDiv = [GroupSize](int32 v){ return (v + GroupSize - 1) / GroupSize; };
-    return FIntVector(CeilDiv(VolumeDimensions.X), CeilDiv(VolumeDimensions.Y), CeilDiv(VolumeDimensions.Z));
-}
+public:
+    DECLARE_GLOBAL_SHADER(FRaymarchConePrepassCS);
+    SHADER_USE_PARAMETER_STRUCT(FRaymarchConePrepassCS, FGlobalShader);
 
-static void AddSplatInstancesPass(
-    FRDGBuilder& GraphBuilder,
-    const FVoxelRenderResource& Resource,
-    FRDGTextureRef DensityTex,
-    const FIntVector& VolumeDimensions,
-    const FVector3f& VolumeMinLS,
-    float VoxelSizeLS)
-{
-    const uint32 NumInstances = Resource.Centers.Num();
-    TArray<FVector4f> PackedCenters; PackedCenters.Reserve(NumInstances);
-    for (uint32 i = 0; i < NumInstances; ++i)
-    {
-        const FVector3f C = Resource.Centers.IsValidIndex(i) ? Resource.Centers[i] : FVector3f::ZeroVector;
-        PackedCenters.Add(FVector4f(C, 1.0f));
-    }
-    FRDGBufferRef InstanceBuffer = CreateStructuredBuffer(GraphBuilder, TEXT("Voxel.InstanceCenters"), sizeof(FVector4f), PackedCenters.Num(), PackedCenters.GetData(), PackedCenters.Num() * sizeof(FVector4f));
-    FRDGBufferSRVRef InstanceSRV = GraphBuilder.CreateSRV(FRDGBufferSRVDesc(InstanceBuffer));
+    class FNarrowBandDim : SHADER_PERMUTATION_BOOL("VOXEL_SDF_NARROW_BAND");
+    using FPermutationDomain = TShaderPermutationDomain<FNarrowBandDim>;
 
-    TArray<float> PackedScales; PackedScales.Reserve(NumInstances);
-    for (uint32 i = 0; i < NumInstances; ++i)
-    {
-        const float S = Resource.Scales.IsValidIndex(i) ? Resource.Scales[i] : 1.0f;
-        PackedScales.Add(S);
-    }
-    
-    FRDGBufferRef ScalesBuffer = CreateStructuredBuffer(GraphBuilder, TEXT("Voxel.InstanceScales"), sizeof(float), PackedScales.Num(), PackedScales.GetData(), PackedScales.Num() * sizeof(float));
-    FRDGBufferSRVRef ScalesSRV = GraphBuilder.CreateSRV(FRDGBufferSRVDesc(ScalesBuffer));
+    BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+        SHADER_PARAMETER(FVector3f, VolumeMinLS)
+        SHADER_PARAMETER(FVector3f, VolumeMaxLS)
+        SHADER_PARAMETER(float, VoxelSizeLS)
+        SHADER_PARAMETER(FMatrix44f, WorldToLocal)
+        SHADER_PARAMETER(FMatrix44f, InvViewProj)
+        SHADER_PARAMETER(FVector3f, CameraWorldPos)
+        SHADER_PARAMETER(FVector2f, ViewportInvSize)
+        SHADER_PARAMETER(FIntVector, VolumeDims)
+        SHADER_PARAMETER(FIntVector, SdfAtlasBricks)
+        SHADER_PARAMETER(FVector3f, SdfAtlasInvSize)
+        SHADER_PARAMETER(float, MinWorldPerLocal)
+        SHADER_PARAMETER(FIntPoint, ConeTileMin)
+        SHADER_PARAMETER(FIntPoint, ConeTileMax)
+        SHADER_PARAMETER(int32, ConeTileSize)
+        SHADER_PARAMETER(uint32, ConeSlice)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture3D<float>, SDFTex)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture3D<uint>, SdfIndirectionTex)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture3D<float>, SdfAtlasTex)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture3D<float>, DensityTex)
+        SHADER_PARAMETER_SAMPLER(SamplerState, SDFSampler)
+        SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2DArray<float>, ConeStartUAV)
+    END_SHADER_PARAMETER_STRUCT()
+};
 
-    TShaderMapRef<FSplatInstancesCS> CS(GetGlobalShaderMap(GMaxRHIFeatureLevel));
-    auto* Params = GraphBuilder.AllocParameters<FSplatInstancesCS::FParameters>();
-    Params->NumInstances     = NumInstances;
-    Params->VolumeMinLS      = VolumeMinLS;
-    Params->VoxelSizeLS      = VoxelSizeLS;
-    Params->VolumeDimensions = VolumeDimensions;
-    Params->InstanceCenters  = InstanceSRV;
-    Params->InstanceScales   = ScalesSRV;
-    Params->DensityUAV       = GraphBuilder.CreateUAV(FRDGTextureUAVDesc(DensityTex, 0));
-    Params->BaseEdgeLengthLS = VoxelSizeLS;
-    Params->OverlapMultiplier = GVoxelOverlapMultiplier;
+class FRaymarchFullscreenVS : public FGlobalShader
+{
+public:
+    DECLARE_GLOBAL_SHADER(FRaymarchFullscreenVS);
+    SHADER_USE_PARAMETER_STRUCT(FRaymarchFullscreenVS, FGlobalShader);
 
-    const uint32 GroupSize = 64u;
-    const uint32 GroupsX   = (NumInstances + GroupSize - 1u) / GroupSize;
-    FComputeShaderUtils::AddPass(GraphBuilder, RDG_EVENT_NAME("Voxel.SplatInstances"), ERDGPassFlags::Compute, CS, Params, FIntVector(GroupsX, 1, 1));
-}
+    BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+    END_SHADER_PARAMETER_STRUCT()
+};
 
-static void AddSeedPass(FRDGBuilder& GraphBuilder, FRDGTextureRef DensityTex, FRDGTextureRef OutSeedTex, const FIntVector& VolumeDimensions, float VoxelSizeLS)
+// Per-volume record of a batched raymarch pass, mirrors FVoxelBatchVolume in VoxelRaymarch.usf
+struct FVoxelBatchVolumeGPU
 {
-    TShaderMapRef<FSeedCS> CS(GetGlobalShaderMap(GMaxRHIFeatureLevel));
-    auto* Params = GraphBuilder.AllocParameters<FSeedCS::FParameters>();
-    Params->VolumeDimensions        = VolumeDimensions;
-    Params->VoxelSizeLS            = VoxelSizeLS;
-    Params->DensityTex = DensityTex;
-    Params->SeedUAV    = GraphBuilder.CreateUAV(FRDGTextureUAVDesc(OutSeedTex, 0));
-    const FIntVector Groups = DivideCeil3D(VolumeDimensions, 8);
-    FComputeShaderUtils::AddPass(GraphBuilder, RDG_EVENT_NAME("Voxel.Seed"), ERDGPassFlags::Compute, CS, Params, Groups);
-}
+    FMatrix44f  LocalToWorld;
+    FMatrix44f  WorldToLocal;
+    FVector4f   VolumeMinLS;    // w = VoxelSizeLS
+    FVector4f   VolumeMaxLS;    // w = cone prepass slice
+    FIntVector4 VolumeDims;     // w = history slot (0 = none)
+};
 
-static FRDGTextureRef AddJFAPasses(FRDGBuilder& GraphBuilder, FRDGTextureRef SeedPing, FRDGTextureRef SeedPong, const FIntVector& VolumeDimensions)
+class FRaymarchBatchedPS : public FGlobalShader
 {
+public:
+    DECLARE_GLOBAL_SHADER(FRaymarchBatchedPS);
+    SHADER_USE_PARAMETER_STRUCT(FRaymarchBatchedPS, FGlobalShader);
+
+    class FTemporalStartDim : SHADER_PERMUTATION_BOOL("VOXEL_RAYMARCH_TEMPORAL_START");
+    class FConeStartDim : SHADER_PERMUTATION_BOOL("VOXEL_RAYMARCH_CONE_START");
+    using FPermutationDomain = TShaderPermutationDomain<FTemporalStartDim, FConeStartDim,
+        FVoxelRaymarchMaxStepsDim, FVoxelRaymarchNormalMethodDim>;
+
+    BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+        SHADER_PARAMETER(uint32, NumBatchVolumes)
+        SHADER_PARAMETER(FMatrix44f, InvViewProj)
+        SHADER_PARAMETER(FMatrix44f, ViewProj)
+        SHADER_PARAMETER(FVector3f, CameraWorldPos)
+        SHADER_PARAMETER(FVector2f, ViewportInvSize)
+        SHADER_PARAMETER(int32, EmptySpaceSkip)
+        SHADER_PARAMETER(int32, DebugStepCount)
+        SHADER_PARAMETER(float, TemporalStartMargin)
+        SHADER_PARAMETER(int32, ConeTileSize)
+        SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<FVoxelBatchVolume>, BatchVolumes)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture3D<float>, SDFTex0)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture3D<float>, SDFTex1)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture3D<float>, SDFTex2)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture3D<float>, SDFTex3)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture3D<float>, SDFTex4)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture3D<float>, SDFTex5)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture3D<float>, SDFTex6)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture3D<float>, SDFTex7)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture3D<float>, DensityTex0)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture3D<float>, DensityTex1)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture3D<float>, DensityTex2)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture3D<float>, DensityTex3)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture3D<float>, DensityTex4)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture3D<float>, DensityTex5)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture3D<float>, DensityTex6)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture3D<float>, DensityTex7)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture3D<float>, SdfMinTex0)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture3D<float>, SdfMinTex1)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture3D<float>, SdfMinTex2)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture3D<float>, SdfMinTex3)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture3D<float>, SdfMinTex4)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture3D<float>, SdfMinTex5)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture3D<float>, SdfMinTex6)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture3D<float>, SdfMinTex7)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture3D<float2>, NormalTex0)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture3D<float2>, NormalTex1)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture3D<float2>, NormalTex2)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture3D<float2>, NormalTex3)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture3D<float2>, NormalTex4)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture3D<float2>, NormalTex5)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture3D<float2>, NormalTex6)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture3D<float2>, NormalTex7)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture2D<float>, SceneDepthTex)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture2D<uint>, TemporalStartTex)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture2DArray<float>, ConeStartTex)
+        SHADER_PARAMETER_SAMPLER(SamplerState, SDFSampler)
+        RENDER_TARGET_BINDING_SLOTS()
+    END_SHADER_PARAMETER_STRUCT()
+
+    static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment)
+    {
+        FGlobalShader::ModifyCompilationEnvironment(Parameters, OutEnvironment);
+        OutEnvironment.SetDefine(TEXT("VOXEL_RAYMARCH_BATCHED"), 1);
+        OutEnvironment.SetDefine(TEXT("VOXEL_BATCH_MAX_VOLUMES"), GVoxelBatchMaxVolumes);
+    }
+};
+
+class FCopySceneDepthCS : public FGlobalShader
+{
+public:
+    DECLARE_GLOBAL_SHADER(FCopySceneDepthCS);
+    SHADER_USE_PARAMETER_STRUCT(FCopySceneDepthCS, FGlobalShader);
+
+    BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+        SHADER_PARAMETER(FIntPoint, SceneDepthExtent)
+        SHADER_PARAMETER(FIntPoint, SceneDepthInputExtent)
+        SHADER_PARAMETER(int32, SceneDepthDivisor)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture2D<float>, SceneDepthInput)
+        SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<float>, SceneDepthCopyUAV)
+    END_SHADER_PARAMETER_STRUCT()
+};
+
+// Per previous-frame history slot: where that volume is now, mirrors FVoxelTemporalRecord in VoxelTemporal.usf
+struct FVoxelTemporalRecordGPU
+{
+    FMatrix44f LocalToWorld;
+    uint32     CurrentSlot = 0;  // 0 = volume gone, hidden or rebuilt since the hit was recorded
+    uint32     Padding[3] = {};
+};
+
+class FVoxelTemporalScatterCS : public FGlobalShader
+{
+public:
+    DECLARE_GLOBAL_SHADER(FVoxelTemporalScatterCS);
+    SHADER_USE_PARAMETER_STRUCT(FVoxelTemporalScatterCS, FGlobalShader);
+
+    BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+        SHADER_PARAMETER(FMatrix44f, ViewProj)
+        SHADER_PARAMETER(FVector3f, CameraWorldPos)
+        SHADER_PARAMETER(FIntPoint, TemporalExtent)
+        SHADER_PARAMETER(uint32, NumTemporalRecords)
+        SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<FVoxelTemporalRecord>, TemporalRecords)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture2D<float4>, HistoryHitTex)
+        SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<uint>, TemporalStartUAV)
+    END_SHADER_PARAMETER_STRUCT()
+};
+
+class FVoxelUpsampleCompositePS : public FGlobalShader
+{
+public:
+    DECLARE_GLOBAL_SHADER(FVoxelUpsampleCompositePS);
+    SHADER_USE_PARAMETER_STRUCT(FVoxelUpsampleCompositePS, FGlobalShader);
+
+    BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+        SHADER_PARAMETER(FIntPoint, LowResExtent)
+        SHADER_PARAMETER(float, ResolutionDivisor)
+        SHADER_PARAMETER(FVector4f, InvDeviceZToWorldZTransform)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture2D<float4>, LowResColorTex)
+        SHADER_PARAMETER_RDG_TEXTURE(Texture2D<float>, LowResDepthTex)
+        RENDER_TARGET_BINDING_SLOTS()
+    END_SHADER_PARAMETER_STRUCT()
+};
+
+// ComputeShaders
+IMPLEMENT_GLOBAL_SHADER(FSplatInstancesCS, "/Voxel/VoxelDensity.usf",       "SplatInstancesCS", SF_Compute);
+IMPLEMENT_GLOBAL_SHADER(FCompactSplatInstancesCS, "/Voxel/VoxelDensity.usf", "CompactSplatInstancesCS", SF_Compute);
+IMPLEMENT_GLOBAL_SHADER(FSplatIndirectArgsCS, "/Voxel/VoxelDensity.usf",    "SplatIndirectArgsCS", SF_Compute);
+IMPLEMENT_GLOBAL_SHADER(FSeedCS,           "/Voxel/VoxelDistanceField.usf", "SeedCS",           SF_Compute);
+IMPLEMENT_GLOBAL_SHADER(FJFACS,            "/Voxel/VoxelDistanceField.usf", "JfaCS",            SF_Compute);
+IMPLEMENT_GLOBAL_SHADER(FEdtCS,            "/Voxel/VoxelDistanceField.usf", "EdtCS",            SF_Compute);
+IMPLEMENT_GLOBAL_SHADER(FSdfBrickBuildCS,  "/Voxel/VoxelDistanceField.usf", "SdfBrickBuildCS",  SF_Compute);
+IMPLEMENT_GLOBAL_SHADER(FSdfMinReduceCS,   "/Voxel/VoxelDistanceField.usf", "SdfMinReduceCS",   SF_Compute);
+IMPLEMENT_GLOBAL_SHADER(FNormalVolumeBuildCS, "/Voxel/VoxelDistanceField.usf", "NormalVolumeBuildCS", SF_Compute);
+IMPLEMENT_GLOBAL_SHADER(FDensityResolveCS, "/Voxel/VoxelDistanceField.usf", "DensityResolveCS", SF_Compute);
+IMPLEMENT_GLOBAL_SHADER(FSdfReadbackCS,    "/Voxel/VoxelDistanceField.usf", "SdfReadbackCS",    SF_Compute);
+
+// RaymarchShaders
+IMPLEMENT_GLOBAL_SHADER(FRaymarchBoundingBoxVS, "/Voxel/VoxelRaymarch.usf", "BoundingBoxVS",    SF_Vertex);
+IMPLEMENT_GLOBAL_SHADER(FRaymarchPS,            "/Voxel/VoxelRaymarch.usf", "RaymarchPS",       SF_Pixel);
+IMPLEMENT_GLOBAL_SHADER(FRaymarchFullscreenVS,  "/Voxel/VoxelRaymarch.usf", "FullscreenVS",     SF_Vertex);
+IMPLEMENT_GLOBAL_SHADER(FRaymarchConePrepassCS, "/Voxel/VoxelRaymarch.usf", "ConePrepassCS",    SF_Compute);
+IMPLEMENT_GLOBAL_SHADER(FRaymarchBatchedPS,     "/Voxel/VoxelRaymarch.usf", "RaymarchBatchedPS", SF_Pixel);
+IMPLEMENT_GLOBAL_SHADER(FCopySceneDepthCS,      "/Voxel/VoxelRaymarch.usf", "CopySceneDepthCS", SF_Compute);
+IMPLEMENT_GLOBAL_SHADER(FVoxelTemporalScatterCS,   "/Voxel/VoxelTemporal.usf", "TemporalScatterCS",   SF_Compute);
+IMPLEMENT_GLOBAL_SHADER(FVoxelUpsampleCompositePS, "/Voxel/VoxelUpsample.usf", "UpsampleCompositePS", SF_Pixel);
+
+static FIntVector DivideCeil3D(const FIntVector& VolumeDimensions, int32 GroupSize)
+{
+    auto CeilDiv = [GroupSize](int32 v){ return (v + GroupSize - 1) / GroupSize; };
+    return FIntVector(CeilDiv(VolumeDimensions.X), CeilDiv(VolumeDimensions.Y), CeilDiv(VolumeDimensions.Z));
+}
+
+// Keeps a structured buffer alive across frames and uploads only the dirty element span through RDG, so the
+// write is ordered against the previous frame's reads of the pooled buffer. A partial span goes through an
+// upload buffer copied in at its offset. The buffer stride matches the CPU element type, so the shader reads the
+// source layout directly.
+template<typename ElementType>
+static FRDGBufferRef UploadPersistentInstanceBuffer(
+    FRDGBuilder& GraphBuilder,
+    TRefCountPtr<FRDGPooledBuffer>& PooledBuffer,
+    const TArray<ElementType>& Data,
+    FVoxelDirtyRange& DirtyRange,
+    const TCHAR* Name)
+{
+    const uint32 NumElements = static_cast<uint32>(Data.Num());
+
+    FRDGBufferRef Buffer = nullptr;
+    if (PooledBuffer.IsValid() && PooledBuffer->Desc.NumElements == NumElements && PooledBuffer->Desc.BytesPerElement == sizeof(ElementType))
+    {
+        Buffer = GraphBuilder.RegisterExternalBuffer(PooledBuffer, Name);
+    }
+    else
+    {
+        Buffer = GraphBuilder.CreateBuffer(FRDGBufferDesc::CreateStructuredDesc(sizeof(ElementType), NumElements), Name);
+        PooledBuffer = GraphBuilder.ConvertToExternalBuffer(Buffer);
+        DirtyRange.Reset();
+        DirtyRange.Add(0, NumElements);
+    }
+
+    if (!DirtyRange.IsEmpty())
+    {
+        const int32 First = FMath::Clamp(DirtyRange.Begin, 0, Data.Num());
+        const int32 Count = FMath::Clamp(DirtyRange.End, First, Data.Num()) - First;
+        DirtyRange.Reset();
+        if (Count > 0)
+        {
+            const uint32 OffsetBytes = First * sizeof(ElementType);
+            const uint32 SizeBytes   = Count * sizeof(ElementType);
+            ElementType* Staging = GraphBuilder.AllocPODArray<ElementType>(Count);
+            FMemory::Memcpy(Staging, Data.GetData() + First, SizeBytes);
+
+            if (Count == Data.Num())
+            {
+                GraphBuilder.QueueBufferUpload(Buffer, Staging, SizeBytes, ERDGInitialDataFlags::NoCopy);
+            }
+            else
+            {
+                FRDGBufferRef UploadBuffer = GraphBuilder.CreateBuffer(FRDGBufferDesc::CreateUploadDesc(sizeof(ElementType), Count), TEXT("Voxel.InstanceUpload"));
+                GraphBuilder.QueueBufferUpload(UploadBuffer, Staging, SizeBytes, ERDGInitialDataFlags::NoCopy);
+                AddCopyBufferPass(GraphBuilder, Buffer, OffsetBytes, UploadBuffer, 0, SizeBytes);
+            }
+        }
+    }
+    return Buffer;
+}
+
+// Allocated atlas slots whose bricks lie within SplatReachCells of [RegionMin, RegionMin + RegionSize); only their
+// instances can splat into the region
+static TArray<uint32> GetSplatSlots(const FVoxelRenderResource& Resource, const FIntVector& RegionMin, const FIntVector& RegionSize)
+{
+    const FVoxelBrickMap& Bricks = Resource.Bricks;
+    const FIntVector Reach(Resource.SplatReachCells);
+    const FIntVector BrickMin = FVoxelBrickMap::CellToBrick(RegionMin - Reach);
+    const FIntVector BrickMax = FVoxelBrickMap::CellToBrick(RegionMin + RegionSize - FIntVector(1) + Reach);
+
+    TArray<uint32> Slots;
+    Slots.Reserve(Bricks.NumBricks());
+    for (int32 Slot = 0; Slot < Bricks.NumSlots(); ++Slot)
+    {
+        const FIntVector4& Coord = Bricks.BrickCoords[Slot];
+        if (Coord.W != 0
+            && Coord.X >= BrickMin.X && Coord.Y >= BrickMin.Y && Coord.Z >= BrickMin.Z
+            && Coord.X <= BrickMax.X && Coord.Y <= BrickMax.Y && Coord.Z <= BrickMax.Z)
+        {
+            Slots.Add(static_cast<uint32>(Slot));
+        }
+    }
+    return Slots;
+}
+
+// Splats the sparse brick atlas into a volume of VolumeDimensions cells starting at cell RegionMin: one thread per
+// cell of the slots that can reach it (GetSplatSlots), empty cells exit early. Cooperative mode first compacts
+// the occupied cells and dispatches its 64-lane groups indirectly over them.
+static void AddSplatInstancesPass(
+    FRDGBuilder& GraphBuilder,
+    FVoxelRenderResource& Resource,
+    FRDGTextureRef DensityTex,
+    const FIntVector& RegionMin,
+    const FIntVector& VolumeDimensions,
+    const FVector3f& VolumeMinLS,
+    float VoxelSizeLS)
+{
+    FVoxelBrickMap& Bricks = Resource.Bricks;
+    const uint32 NumInstances = Bricks.NumAtlasCells();
+    FRDGBufferRef CentersBuffer     = UploadPersistentInstanceBuffer(GraphBuilder, Resource.CentersBuffer,     Bricks.Centers,     Resource.CentersDirty,     TEXT("Voxel.BrickAtlasCenters"));
+    FRDGBufferRef ScalesBuffer      = UploadPersistentInstanceBuffer(GraphBuilder, Resource.ScalesBuffer,      Bricks.Scales,      Resource.ScalesDirty,      TEXT("Voxel.BrickAtlasScales"));
+    FRDGBufferRef BrickCoordsBuffer = UploadPersistentInstanceBuffer(GraphBuilder, Resource.BrickCoordsBuffer, Bricks.BrickCoords, Resource.BrickCoordsDirty, TEXT("Voxel.BrickCoords"));
+
+    const TArray<uint32> Slots = GetSplatSlots(Resource, RegionMin, VolumeDimensions);
+    if (Slots.IsEmpty())
+    {
+        return;
+    }
+    FRDGBufferRef SlotsBuffer = CreateStructuredBuffer(GraphBuilder, TEXT("Voxel.SplatSlots"), Slots);
+
+    const int32 SplatMode = CVarVoxelSplatMode.GetValueOnAnyThread();
+    const bool bCooperative = SplatMode == 1;
+    const uint32 GroupSize = 64u;
+    const uint32 NumSplatCells = Slots.Num() * FVoxelBrickMap::CellsPerBrick;
+    const FIntVector Groups = FComputeShaderUtils::GetGroupCountWrapped(FMath::DivideAndRoundUp(NumSplatCells, GroupSize));
+
+    FRDGBufferRef SplatListBuffer = nullptr;
+    FRDGBufferRef SplatListCountBuffer = nullptr;
+    FRDGBufferRef IndirectArgsBuffer = nullptr;
+    // Wrapping for the worst case of one group per listed cell; the indirect args only use as many rows as needed
+    const FIntVector CooperativeGroups = FComputeShaderUtils::GetGroupCountWrapped(NumSplatCells);
+    if (bCooperative)
+    {
+        SplatListBuffer      = GraphBuilder.CreateBuffer(FRDGBufferDesc::CreateStructuredDesc(sizeof(uint32), NumSplatCells), TEXT("Voxel.SplatList"));
+        SplatListCountBuffer = GraphBuilder.CreateBuffer(FRDGBufferDesc::CreateStructuredDesc(sizeof(uint32), 1), TEXT("Voxel.SplatListCount"));
+        IndirectArgsBuffer   = GraphBuilder.CreateBuffer(FRDGBufferDesc::CreateIndirectDesc<FRHIDispatchIndirectParameters>(1), TEXT("Voxel.SplatIndirectArgs"));
+        FRDGBufferUAVRef SplatListCountUAV = GraphBuilder.CreateUAV(SplatListCountBuffer);
+        AddClearUAVPass(GraphBuilder, SplatListCountUAV, 0u);
+
+        TShaderMapRef<FCompactSplatInstancesCS> CompactCS(GetGlobalShaderMap(GMaxRHIFeatureLevel));
+        auto* CompactParams = GraphBuilder.AllocParameters<FCompactSplatInstancesCS::FParameters>();
+        CompactParams->NumInstances      = NumInstances;
+        CompactParams->DispatchGroupsX   = Groups.X;
+        CompactParams->VolumeMinLS       = VolumeMinLS;
+        CompactParams->VoxelSizeLS       = VoxelSizeLS;
+        CompactParams->VolumeDimensions  = VolumeDimensions;
+        CompactParams->InstanceCenters   = GraphBuilder.CreateSRV(FRDGBufferSRVDesc(CentersBuffer));
+        CompactParams->InstanceScales    = GraphBuilder.CreateSRV(FRDGBufferSRVDesc(ScalesBuffer));
+        CompactParams->BrickCoords       = GraphBuilder.CreateSRV(FRDGBufferSRVDesc(BrickCoordsBuffer));
+        CompactParams->SplatSlots        = GraphBuilder.CreateSRV(FRDGBufferSRVDesc(SlotsBuffer));
+        CompactParams->NumSplatSlots     = Slots.Num();
+        CompactParams->BaseEdgeLengthLS  = VoxelSizeLS;
+        CompactParams->OverlapMultiplier = GVoxelOverlapMultiplier;
+        CompactParams->SplatListUAV      = GraphBuilder.CreateUAV(SplatListBuffer);
+        CompactParams->SplatListCountUAV = SplatListCountUAV;
+        FComputeShaderUtils::AddPass(GraphBuilder, RDG_EVENT_NAME("Voxel.CompactSplatInstances"), ERDGPassFlags::Compute, CompactCS, CompactParams, Groups);
+
+        TShaderMapRef<FSplatIndirectArgsCS> ArgsCS(GetGlobalShaderMap(GMaxRHIFeatureLevel));
+        auto* ArgsParams = GraphBuilder.AllocParameters<FSplatIndirectArgsCS::FParameters>();
+        ArgsParams->DispatchGroupsX      = CooperativeGroups.X;
+        ArgsParams->SplatListCount       = GraphBuilder.CreateSRV(FRDGBufferSRVDesc(SplatListCountBuffer));
+        ArgsParams->SplatIndirectArgsUAV = GraphBuilder.CreateUAV(IndirectArgsBuffer, PF_R32_UINT);
+        FComputeShaderUtils::AddPass(GraphBuilder, RDG_EVENT_NAME("Voxel.SplatIndirectArgs"), ERDGPassFlags::Compute, ArgsCS, ArgsParams, FIntVector(1, 1, 1));
+    }
+
+    FSplatInstancesCS::FPermutationDomain PermutationVector;
+    PermutationVector.Set<FSplatInstancesCS::FCooperativeDim>(bCooperative);
+    PermutationVector.Set<FSplatInstancesCS::FTiledDim>(SplatMode == 2);
+    TShaderMapRef<FSplatInstancesCS> CS(GetGlobalShaderMap(GMaxRHIFeatureLevel), PermutationVector);
+    auto* Params = GraphBuilder.AllocParameters<FSplatInstancesCS::FParameters>();
+    Params->NumInstances     = NumInstances;
+    Params->DispatchGroupsX  = bCooperative ? CooperativeGroups.X : Groups.X;
+    Params->VolumeMinLS      = VolumeMinLS;
+    Params->VoxelSizeLS      = VoxelSizeLS;
+    Params->VolumeDimensions = VolumeDimensions;
+    Params->InstanceCenters  = GraphBuilder.CreateSRV(FRDGBufferSRVDesc(CentersBuffer));
+    Params->InstanceScales   = GraphBuilder.CreateSRV(FRDGBufferSRVDesc(ScalesBuffer));
+    Params->BrickCoords      = GraphBuilder.CreateSRV(FRDGBufferSRVDesc(BrickCoordsBuffer));
+    Params->SplatSlots       = GraphBuilder.CreateSRV(FRDGBufferSRVDesc(SlotsBuffer));
+    Params->NumSplatSlots    = Slots.Num();
+    Params->DensityUAV       = GraphBuilder.CreateUAV(FRDGTextureUAVDesc(DensityTex, 0));
+    Params->BaseEdgeLengthLS = VoxelSizeLS;
+    Params->OverlapMultiplier = GVoxelOverlapMultiplier;
+
+    if (bCooperative)
+    {
+        Params->SplatList      = GraphBuilder.CreateSRV(FRDGBufferSRVDesc(SplatListBuffer));
+        Params->SplatListCount = GraphBuilder.CreateSRV(FRDGBufferSRVDesc(SplatListCountBuffer));
+        Params->IndirectArgs   = IndirectArgsBuffer;
+        FComputeShaderUtils::AddPass(GraphBuilder, RDG_EVENT_NAME("Voxel.SplatInstances cooperative (%d slots)", Slots.Num()), ERDGPassFlags::Compute, CS, Params, IndirectArgsBuffer, 0);
+        return;
+    }
+    FComputeShaderUtils::AddPass(GraphBuilder, RDG_EVENT_NAME("Voxel.SplatInstances (%d slots)", Slots.Num()), ERDGPassFlags::Compute, CS, Params, Groups);
+}
+
+// Sub-volume a rebuild runs in. The splat, seed and propagation passes cover Size cells from Origin and only
+// [UpdateMin, UpdateMax) (relative to Origin) is written back to the persistent volumes; a full rebuild is the
+// whole volume with a zero origin.
+struct FVoxelRebuildRegion
+{
+    FIntVector Origin    = FIntVector::ZeroValue;
+    FIntVector Size      = FIntVector::ZeroValue;
+    FIntVector UpdateMin = FIntVector::ZeroValue;
+    FIntVector UpdateMax = FIntVector::ZeroValue;
+    float MarginLS = 0.0f;   // distance from the update box to the cells outside Size
+    bool bPartial  = false;
+
+    static FVoxelRebuildRegion Full(const FIntVector& VolumeDimensions)
+    {
+        FVoxelRebuildRegion Region;
+        Region.Size      = VolumeDimensions;
+        Region.UpdateMax = VolumeDimensions;
+        return Region;
+    }
+
+    int64 GetNumVoxels() const
+    {
+        return int64(Size.X) * Size.Y * Size.Z;
+    }
+
+    template<typename ParametersType>
+    void SetParameters(ParametersType& Params) const
+    {
+        Params.RegionOrigin = Origin;
+        Params.UpdateMin    = UpdateMin;
+        Params.UpdateMax    = UpdateMax;
+    }
+};
+
+// Inputs shared by the seed and propagation passes of one rebuild
+struct FVoxelDistanceFieldInputs
+{
+    FRDGTextureRef DensityTex = nullptr;   // fixed-point splat accumulation over Region.Size
+    FIntVector VolumeDimensions = FIntVector::ZeroValue;   // of the region; VolumeMinLS is its first cell's corner
+    FVector3f VolumeMinLS = FVector3f::ZeroVector;
+    FVoxelRebuildRegion Region;
+    float VoxelSizeLS = 1.0f;
+    bool bPackedSeeds = false;
+    bool bTiled = true;
+    FRDGTextureRef PrevSeedTex = nullptr;   // JFA warm start: final seed field of the previous build
+    FRDGTextureRef KeepSeedTex = nullptr;   // JFA: the last step also stores its seeds here for the next warm start
+
+    FRDGTextureDesc GetSeedDesc() const
+    {
+        return FRDGTextureDesc::Create3D(VolumeDimensions, bPackedSeeds ? PF_R32_UINT : PF_A32B32G32R32F, FClearValueBinding::None, TexCreate_ShaderResource | TexCreate_UAV);
+    }
+};
+
+// WarmStep > 0 merges Inputs.PrevSeedTex into the seeds for a warm JFA schedule starting at that step
+static void AddSeedPass(FRDGBuilder& GraphBuilder, const FVoxelDistanceFieldInputs& Inputs, FRDGTextureRef OutSeedTex, int32 WarmStep = 0)
+{
+    RDG_GPU_STAT_SCOPE(GraphBuilder, VoxelSeed);
+    FSeedCS::FPermutationDomain PermutationVector;
+    PermutationVector.Set<FVoxelSeedPackedDim>(Inputs.bPackedSeeds);
+    PermutationVector.Set<FSeedCS::FTiledDim>(Inputs.bTiled);
+    PermutationVector.Set<FSeedCS::FWarmDim>(WarmStep > 0);
+    TShaderMapRef<FSeedCS> CS(GetGlobalShaderMap(GMaxRHIFeatureLevel), PermutationVector);
+    auto* Params = GraphBuilder.AllocParameters<FSeedCS::FParameters>();
+    Params->VolumeDimensions = Inputs.VolumeDimensions;
+    Params->VoxelSizeLS      = Inputs.VoxelSizeLS;
+    Params->Step             = WarmStep;
+    Params->DensityTex       = Inputs.DensityTex;
+    Params->InSeed           = WarmStep > 0 ? Inputs.PrevSeedTex : nullptr;
+    Params->SeedUAV          = GraphBuilder.CreateUAV(FRDGTextureUAVDesc(OutSeedTex, 0));
+    const FIntVector Groups = DivideCeil3D(Inputs.VolumeDimensions, 8);
+    FComputeShaderUtils::AddPass(GraphBuilder, RDG_EVENT_NAME("Voxel.Seed%s", WarmStep > 0 ? TEXT(" (warm)") : TEXT("")), ERDGPassFlags::Compute, CS, Params, Groups);
+}
+
+// The last step writes the SDF, so the schedule needs no separate distance conversion pass. A warm start replaces
+// the large steps with the previous build's seed field, merged in by the seed pass.
+static void AddJFAPasses(FRDGBuilder& GraphBuilder, const FVoxelDistanceFieldInputs& Inputs, FRDGTextureRef OutSdf)
+{
+    const FIntVector& VolumeDimensions = Inputs.VolumeDimensions;
     int32 MaxDim = FMath::Max3(VolumeDimensions.X, VolumeDimensions.Y, VolumeDimensions.Z);
     int32 Step = 1 << (31 - FMath::CountLeadingZeros(MaxDim));
-    bool bPingToPong = true;
+    const bool bWarmStart = Inputs.PrevSeedTex != nullptr;
+    if (bWarmStart)
+    {
+        Step = FMath::Min(Step, GVoxelJfaWarmStartStep);
+    }
+    const float WarmReachLS = bWarmStart ? (2 * Step - 1) * Inputs.VoxelSizeLS : 0.0f;
+
+    const FRDGTextureDesc SeedDesc = Inputs.GetSeedDesc();
+    FRDGTextureRef SeedPing = GraphBuilder.CreateTexture(SeedDesc, TEXT("Voxel.SeedPing"));
+    FRDGTextureRef SeedPong = Step > 1 ? GraphBuilder.CreateTexture(SeedDesc, TEXT("Voxel.SeedPong")) : nullptr;
+    AddSeedPass(GraphBuilder, Inputs, SeedPing, bWarmStart ? Step : 0);
+    FRDGTextureRef InSeed = SeedPing;
+
+    const int32 MaxTileStep = Inputs.bTiled ? FJFACS::GetMaxTileStep(Inputs.bPackedSeeds) : 0;
+
+    auto AddStep = [&]()
+    {
+        const bool bLast = Step == 1;
+        const bool bTiled = Step <= MaxTileStep;
+        FJFACS::FPermutationDomain PermutationVector;
+        PermutationVector.Set<FVoxelSeedPackedDim>(Inputs.bPackedSeeds);
+        PermutationVector.Set<FVoxelWriteSdfDim>(bLast);
+        PermutationVector.Set<FJFACS::FTileStepDim>(bTiled ? Step : 0);
+        PermutationVector.Set<FJFACS::FKeepSeedDim>(bLast && Inputs.KeepSeedTex != nullptr);
+        PermutationVector.Set<FVoxelRegionDim>(bLast && Inputs.Region.bPartial);
+        TShaderMapRef<FJFACS> CS(GetGlobalShaderMap(GMaxRHIFeatureLevel), PermutationVector);
+
+        FRDGTextureRef OutSeed = InSeed == SeedPing ? SeedPong : SeedPing;
+        auto* Params = GraphBuilder.AllocParameters<FJFACS::FParameters>();
+        Params->VolumeDimensions = VolumeDimensions;
+        Params->VolumeMinLS      = Inputs.VolumeMinLS;
+        Params->VoxelSizeLS      = Inputs.VoxelSizeLS;
+        Params->Step             = Step;
+        Params->RegionMarginLS   = Inputs.Region.MarginLS;
+        Params->WarmReachLS      = WarmReachLS;
+        Inputs.Region.SetParameters(*Params);
+        Params->DensityTex       = Inputs.DensityTex;
+        Params->InSeed           = InSeed;
+        if (bLast)
+        {
+            Params->SdfUAV  = GraphBuilder.CreateUAV(FRDGTextureUAVDesc(OutSdf, 0));
+            if (Inputs.KeepSeedTex)
+            {
+                Params->OutSeed = GraphBuilder.CreateUAV(FRDGTextureUAVDesc(Inputs.KeepSeedTex, 0));
+            }
+        }
+        else
+        {
+            Params->OutSeed = GraphBuilder.CreateUAV(FRDGTextureUAVDesc(OutSeed, 0));
+        }
+        const FIntVector Groups = DivideCeil3D(VolumeDimensions, 8);
+        FComputeShaderUtils::AddPass(GraphBuilder, RDG_EVENT_NAME("Voxel.JFA step=%d%s", Step, bTiled ? TEXT(" (tiled)") : TEXT("")), ERDGPassFlags::Compute, CS, Params, Groups);
+
+        InSeed = OutSeed;
+        Step >>= 1;
+    };
+
+    while (Step > 4)
+    {
+        AddStep();
+    }
+
+    // Separate stat so r.Voxel.DistanceTransform.Tiled can be compared directly
+    RDG_GPU_STAT_SCOPE(GraphBuilder, VoxelJfaSmallSteps);
     while (Step >= 1)
     {
-        TShaderMapRef<FJFACS> CS(GetGlobalShaderMap(GMaxRHIFeatureLevel));
-        auto* Params = GraphBuilder.AllocParameters<FJFACS::FParameters>();
-        Params->VolumeDimensions  = VolumeDimensions;
-        Params->Step = Step;
-        Params->InSeed  = bPingToPong ? SeedPing : SeedPong;
-        Params->OutSeed = GraphBuilder.CreateUAV(FRDGTextureUAVDesc(bPingToPong ? SeedPong : SeedPing, 0));
-        const FIntVector Groups = DivideCeil3D(VolumeDimensions, 8);
-        FComputeShaderUtils::AddPass(GraphBuilder, RDG_EVENT_NAME("Voxel.JFA step=%d", Step), ERDGPassFlags::Compute, CS, Params, Groups);
-        bPingToPong = !bPingToPong;
-        Step >>= 1;
+        AddStep();
+    }
+}
+
+// Seed pass followed by three 1D passes (X, Y, Z) of the exact squared EDT, one group per line; the Z pass writes the SDF
+static void AddEdtPasses(FRDGBuilder& GraphBuilder, const FVoxelDistanceFieldInputs& Inputs, FRDGTextureRef OutSdf)
+{
+    const FIntVector& VolumeDimensions = Inputs.VolumeDimensions;
+    const FRDGTextureDesc SeedDesc = Inputs.GetSeedDesc();
+    FRDGTextureRef SeedPing = GraphBuilder.CreateTexture(SeedDesc, TEXT("Voxel.SeedPing"));
+    FRDGTextureRef SeedPong = GraphBuilder.CreateTexture(SeedDesc, TEXT("Voxel.SeedPong"));
+    AddSeedPass(GraphBuilder, Inputs, SeedPing);
+
+    bool bPingToPong = true;
+    for (int32 Axis = 0; Axis < 3; ++Axis)
+    {
+        const bool bLast = Axis == 2;
+        FEdtCS::FPermutationDomain PermutationVector;
+        PermutationVector.Set<FVoxelSeedPackedDim>(Inputs.bPackedSeeds);
+        PermutationVector.Set<FVoxelWriteSdfDim>(bLast);
+        PermutationVector.Set<FVoxelRegionDim>(bLast && Inputs.Region.bPartial);
+        TShaderMapRef<FEdtCS> CS(GetGlobalShaderMap(GMaxRHIFeatureLevel), PermutationVector);
+
+        auto* Params = GraphBuilder.AllocParameters<FEdtCS::FParameters>();
+        Params->VolumeDimensions = VolumeDimensions;
+        Params->VolumeMinLS      = Inputs.VolumeMinLS;
+        Params->VoxelSizeLS      = Inputs.VoxelSizeLS;
+        Params->LineAxis         = Axis;
+        Params->RegionMarginLS   = Inputs.Region.MarginLS;
+        Inputs.Region.SetParameters(*Params);
+        Params->DensityTex       = Inputs.DensityTex;
+        Params->InSeed           = bPingToPong ? SeedPing : SeedPong;
+        if (bLast)
+        {
+            Params->SdfUAV  = GraphBuilder.CreateUAV(FRDGTextureUAVDesc(OutSdf, 0));
+        }
+        else
+        {
+            Params->OutSeed = GraphBuilder.CreateUAV(FRDGTextureUAVDesc(bPingToPong ? SeedPong : SeedPing, 0));
+        }
+        const FIntVector Groups(
+            Axis == 0 ? VolumeDimensions.Y : VolumeDimensions.X,
+            Axis == 2 ? VolumeDimensions.Y : VolumeDimensions.Z,
+            1);
+        FComputeShaderUtils::AddPass(GraphBuilder, RDG_EVENT_NAME("Voxel.EDT axis=%d", Axis), ERDGPassFlags::Compute, CS, Params, Groups);
+        bPingToPong = !bPingToPong;
+    }
+}
+
+// The EDT falls back to JFA for lines longer than its groupshared envelope
+static bool UsesExactEdt(EVoxelDistanceTransform Mode, const FIntVector& VolumeDimensions)
+{
+    return Mode == EVoxelDistanceTransform::ExactEdt
+        && FMath::Max3(VolumeDimensions.X, VolumeDimensions.Y, VolumeDimensions.Z) <= GVoxelEdtMaxLine;
+}
+
+// Fills every cell of OutSdf, so the SDF needs no clear beforehand
+static void AddDistanceFieldPasses(FRDGBuilder& GraphBuilder, EVoxelDistanceTransform Mode, const FVoxelDistanceFieldInputs& Inputs, FRDGTextureRef OutSdf)
+{
+    if (UsesExactEdt(Mode, Inputs.VolumeDimensions))
+    {
+        RDG_GPU_STAT_SCOPE(GraphBuilder, VoxelDistanceTransformEDT);
+        AddEdtPasses(GraphBuilder, Inputs, OutSdf);
+        return;
+    }
+
+    RDG_GPU_STAT_SCOPE(GraphBuilder, VoxelDistanceTransformJFA);
+    AddJFAPasses(GraphBuilder, Inputs, OutSdf);
+}
+
+BEGIN_SHADER_PARAMETER_STRUCT(FVoxelTextureUploadParameters, )
+    RDG_TEXTURE_ACCESS(Texture, ERHIAccess::CopyDest)
+END_SHADER_PARAMETER_STRUCT()
+
+void ComputeVoxelSquaredDistancesGpu(
+    FRHICommandListImmediate& RHICmdList,
+    const FIntVector& Dims,
+    const TArray<bool>& Sites,
+    bool bExactEdt,
+    bool bPackedSeeds,
+    bool bTiled,
+    TArray<float>& OutSquaredDistances)
+{
+    check(IsInRenderingThread());
+    const int32 NumCells = Dims.X * Dims.Y * Dims.Z;
+    check(Sites.Num() == NumCells);
+
+    FRHIGPUBufferReadback Readback(TEXT("Voxel.DistanceTransformReadback"));
+    {
+        FRDGBuilder GraphBuilder(RHICmdList);
+
+        // Fully inside site cells in an empty volume, so every site is a surface cell seeded at its own center
+        uint32* Density = GraphBuilder.AllocPODArray<uint32>(NumCells);
+        for (int32 Index = 0; Index < NumCells; ++Index)
+        {
+            Density[Index] = Sites[Index] ? 10000u : 0u;
+        }
+        FRDGTextureRef DensityTex = GraphBuilder.CreateTexture(
+            FRDGTextureDesc::Create3D(Dims, PF_R32_UINT, FClearValueBinding::None, TexCreate_ShaderResource | TexCreate_UAV),
+            TEXT("Voxel.DistanceTransformDensity"));
+        auto* UploadParams = GraphBuilder.AllocParameters<FVoxelTextureUploadParameters>();
+        UploadParams->Texture = DensityTex;
+        GraphBuilder.AddPass(RDG_EVENT_NAME("Voxel.UploadDensity"), UploadParams, ERDGPassFlags::Copy | ERDGPassFlags::NeverCull,
+            [UploadParams, Density, Dims](FRHICommandListImmediate& RHICmdList)
+            {
+                const FUpdateTextureRegion3D UpdateRegion(0, 0, 0, 0, 0, 0, Dims.X, Dims.Y, Dims.Z);
+                RHICmdList.UpdateTexture3D(UploadParams->Texture->GetRHI(), 0, UpdateRegion,
+                    Dims.X * sizeof(uint32), Dims.X * Dims.Y * sizeof(uint32), reinterpret_cast<const uint8*>(Density));
+            });
+
+        FVoxelDistanceFieldInputs Inputs;
+        Inputs.DensityTex       = DensityTex;
+        Inputs.VolumeDimensions = Dims;
+        Inputs.Region           = FVoxelRebuildRegion::Full(Dims);
+        Inputs.bPackedSeeds     = bPackedSeeds;
+        Inputs.bTiled           = bTiled;
+        FRDGTextureRef SdfTex = GraphBuilder.CreateTexture(
+            FRDGTextureDesc::Create3D(Dims, PF_R32_FLOAT, FClearValueBinding::None, TexCreate_ShaderResource | TexCreate_UAV),
+            TEXT("Voxel.DistanceTransformSdf"));
+        AddDistanceFieldPasses(GraphBuilder, bExactEdt ? EVoxelDistanceTransform::ExactEdt : EVoxelDistanceTransform::JumpFlood, Inputs, SdfTex);
+
+        FRDGBufferRef SdfBuffer = GraphBuilder.CreateBuffer(FRDGBufferDesc::CreateStructuredDesc(sizeof(float), NumCells), TEXT("Voxel.DistanceTransformSdfLinear"));
+        TShaderMapRef<FSdfReadbackCS> CS(GetGlobalShaderMap(GMaxRHIFeatureLevel));
+        auto* Params = GraphBuilder.AllocParameters<FSdfReadbackCS::FParameters>();
+        Params->VolumeDimensions = Dims;
+        Params->DenseSdfTex      = SdfTex;
+        Params->SdfReadbackUAV   = GraphBuilder.CreateUAV(SdfBuffer);
+        FComputeShaderUtils::AddPass(GraphBuilder, RDG_EVENT_NAME("Voxel.SdfReadback"), ERDGPassFlags::Compute, CS, Params, DivideCeil3D(Dims, 8));
+
+        AddEnqueueCopyPass(GraphBuilder, &Readback, SdfBuffer, NumCells * sizeof(float));
+        GraphBuilder.Execute();
+    }
+
+    RHICmdList.SubmitCommandsAndFlushGPU();
+    RHICmdList.BlockUntilGPUIdle();
+    while (!Readback.IsReady())
+    {
+        FPlatformProcess::SleepNoStats(0.001f);
+    }
+
+    // VoxelSizeLS is 1, so the distances are already in cells; 1e6 marks a volume without sites
+    const float* Sdf = static_cast<const float*>(Readback.Lock(NumCells * sizeof(float)));
+    OutSquaredDistances.SetNumUninitialized(NumCells);
+    for (int32 Index = 0; Index < NumCells; ++Index)
+    {
+        const float Distance = FMath::Abs(Sdf[Index]);
+        OutSquaredDistances[Index] = Distance >= 1e5f ? -1.0f : Distance * Distance;
+    }
+    Readback.Unlock();
+}
+
+struct FVoxelRenderTextureResult
+{
+    FRDGTextureRef SdfTex = nullptr;
+    FRDGTextureRef SdfMinTex = nullptr;
+    FRDGTextureRef SdfAtlasTex = nullptr;
+    FRDGTextureRef SdfIndirectionTex = nullptr;
+    FRDGTextureRef DensityTex = nullptr;
+    FRDGTextureRef NormalTex = nullptr;
+    FIntVector VolumeDimensions = FIntVector::ZeroValue;
+    FIntVector SdfAtlasBricks = FIntVector::ZeroValue;
+
+    bool IsNarrowBand() const { return SdfAtlasTex != nullptr; }
+    bool HasSdf() const { return SdfTex != nullptr || SdfAtlasTex != nullptr; }
+};
+
+static FIntVector GetSdfBrickGridDims(const FIntVector& VolumeDimensions)
+{
+    return DivideCeil3D(VolumeDimensions, GVoxelSdfBrickSize);
+}
+
+static FIntVector GetSdfAtlasBricks(uint32 Capacity)
+{
+    const int32 X = FMath::Min<int32>(Capacity, GVoxelSdfAtlasBricksXY);
+    const int32 Y = FMath::Min<int32>(FMath::DivideAndRoundUp<int32>(Capacity, GVoxelSdfAtlasBricksXY), GVoxelSdfAtlasBricksXY);
+    const int32 Z = FMath::DivideAndRoundUp<int32>(Capacity, GVoxelSdfAtlasBricksXY * GVoxelSdfAtlasBricksXY);
+    return FIntVector(X, Y, Z);
+}
+
+// Grows the atlas when the previous build allocated more surface bricks than it could hold
+static void UpdateSdfBrickCapacity(FVoxelRenderResource& Resource, const FIntVector& BrickGridDims)
+{
+    if (Resource.SdfBrickCapacity == 0)
+    {
+        const uint32 NumBricks = BrickGridDims.X * BrickGridDims.Y * BrickGridDims.Z;
+        Resource.SdfBrickCapacity = FMath::Min<uint32>(NumBricks, FMath::Max<uint32>(GVoxelSdfMinBrickCapacity, NumBricks / 4));
+    }
+
+    if (Resource.SdfBrickCountReadback.IsValid() && Resource.SdfBrickCountReadback->IsReady())
+    {
+        const uint32 Allocated = *static_cast<const uint32*>(Resource.SdfBrickCountReadback->Lock(sizeof(uint32)));
+        Resource.SdfBrickCountReadback->Unlock();
+        Resource.SdfBrickCountReadback.Reset();
+        if (Allocated > Resource.SdfBrickCapacity)
+        {
+            Resource.SdfBrickCapacity = FMath::RoundUpToPowerOfTwo(Allocated);
+            Resource.MarkDirty();
+        }
+    }
+}
+
+// Per-block signed minimum of the dense SDF for empty-space skipping in the raymarcher. Only the blocks whose
+// footprint (block plus one voxel apron) overlaps the region's update box are reduced again.
+static void AddSdfMinReducePass(FRDGBuilder& GraphBuilder, FRDGTextureRef DenseSdf, FRDGTextureRef OutSdfMin, const FIntVector& VolumeDimensions, const FVoxelRebuildRegion& Region)
+{
+    const FIntVector UpdateMin = Region.Origin + Region.UpdateMin;
+    const FIntVector UpdateMax = Region.Origin + Region.UpdateMax;
+    const FIntVector BrickMin(
+        FMath::Max(0, (UpdateMin.X - 1) / GVoxelSdfBrickSize),
+        FMath::Max(0, (UpdateMin.Y - 1) / GVoxelSdfBrickSize),
+        FMath::Max(0, (UpdateMin.Z - 1) / GVoxelSdfBrickSize));
+    const FIntVector BrickMax = GetSdfBrickGridDims(UpdateMax + FIntVector(1));
+    const FIntVector BrickGridDims = GetSdfBrickGridDims(VolumeDimensions);
+    const FIntVector BrickCount(
+        FMath::Min(BrickMax.X, BrickGridDims.X) - BrickMin.X,
+        FMath::Min(BrickMax.Y, BrickGridDims.Y) - BrickMin.Y,
+        FMath::Min(BrickMax.Z, BrickGridDims.Z) - BrickMin.Z);
+
+    TShaderMapRef<FSdfMinReduceCS> CS(GetGlobalShaderMap(GMaxRHIFeatureLevel));
+    auto* Params = GraphBuilder.AllocParameters<FSdfMinReduceCS::FParameters>();
+    Params->VolumeDimensions = VolumeDimensions;
+    Params->BrickOffset      = BrickMin;
+    Params->DenseSdfTex      = DenseSdf;
+    Params->SdfMinUAV        = GraphBuilder.CreateUAV(FRDGTextureUAVDesc(OutSdfMin, 0));
+    FComputeShaderUtils::AddPass(GraphBuilder, RDG_EVENT_NAME("Voxel.SdfMinReduce"), ERDGPassFlags::Compute, CS, Params, BrickCount);
+}
+
+// Dense SDF -> surface bricks in the atlas + constant-encoded empty/interior bricks in the indirection volume, for
+// the bricks [BrickMin, BrickMax). DenseSdf covers those bricks and their apron from its first cell DenseSdfOrigin.
+static void AddSdfBrickBuildPass(
+    FRDGBuilder& GraphBuilder,
+    const FVoxelRenderResource& Resource,
+    FRDGTextureRef DenseSdf,
+    const FIntVector& DenseSdfOrigin,
+    FRDGTextureRef OutIndirection,
+    FRDGTextureRef OutAtlas,
+    FRDGBufferUAVRef CounterUAV,
+    const FIntVector& VolumeDimensions,
+    const FIntVector& AtlasBricks,
+    const FIntVector& BrickMin,
+    const FIntVector& BrickMax,
+    float NarrowBandLS)
+{
+    TShaderMapRef<FSdfBrickBuildCS> CS(GetGlobalShaderMap(GMaxRHIFeatureLevel));
+    auto* Params = GraphBuilder.AllocParameters<FSdfBrickBuildCS::FParameters>();
+    Params->VolumeDimensions   = VolumeDimensions;
+    Params->SdfAtlasBricks     = AtlasBricks;
+    Params->SdfBrickCapacity   = Resource.SdfBrickCapacity;
+    Params->NarrowBandLS       = NarrowBandLS;
+    Params->BrickOffset        = BrickMin;
+    Params->DenseSdfOrigin     = DenseSdfOrigin;
+    Params->DenseSdfTex        = DenseSdf;
+    Params->SdfIndirectionUAV  = GraphBuilder.CreateUAV(FRDGTextureUAVDesc(OutIndirection, 0));
+    Params->SdfAtlasUAV        = GraphBuilder.CreateUAV(FRDGTextureUAVDesc(OutAtlas, 0));
+    Params->SdfBrickCounterUAV = CounterUAV;
+    FComputeShaderUtils::AddPass(GraphBuilder, RDG_EVENT_NAME("Voxel.SdfBrickBuild"), ERDGPassFlags::Compute, CS, Params, BrickMax - BrickMin);
+}
+
+// Octahedral-encoded density gradient for single-fetch shading normals
+static void AddNormalVolumePass(FRDGBuilder& GraphBuilder, FRDGTextureRef DensityAccumTex, FRDGTextureRef OutNormal, const FVoxelRebuildRegion& Region)
+{
+    TShaderMapRef<FNormalVolumeBuildCS> CS(GetGlobalShaderMap(GMaxRHIFeatureLevel));
+    auto* Params = GraphBuilder.AllocParameters<FNormalVolumeBuildCS::FParameters>();
+    Params->VolumeDimensions = Region.Size;
+    Region.SetParameters(*Params);
+    Params->DensityTex       = DensityAccumTex;
+    Params->NormalUAV        = GraphBuilder.CreateUAV(FRDGTextureUAVDesc(OutNormal, 0));
+    FComputeShaderUtils::AddPass(GraphBuilder, RDG_EVENT_NAME("Voxel.NormalVolume"), ERDGPassFlags::Compute, CS, Params, DivideCeil3D(Region.UpdateMax - Region.UpdateMin, 8));
+}
+
+static void AddDensityResolvePass(FRDGBuilder& GraphBuilder, FRDGTextureRef DensityAccumTex, FRDGTextureRef OutDensity, const FVoxelRebuildRegion& Region)
+{
+    TShaderMapRef<FDensityResolveCS> CS(GetGlobalShaderMap(GMaxRHIFeatureLevel));
+    auto* Params = GraphBuilder.AllocParameters<FDensityResolveCS::FParameters>();
+    Params->VolumeDimensions   = Region.Size;
+    Region.SetParameters(*Params);
+    Params->DensityTex         = DensityAccumTex;
+    Params->DensityResolvedUAV = GraphBuilder.CreateUAV(FRDGTextureUAVDesc(OutDensity, 0));
+    FComputeShaderUtils::AddPass(GraphBuilder, RDG_EVENT_NAME("Voxel.DensityResolve"), ERDGPassFlags::Compute, CS, Params, DivideCeil3D(Region.UpdateMax - Region.UpdateMin, 8));
+}
+
+// Reuses the pooled texture when it still matches the requested layout, otherwise allocates a new one
+// and hands it back to the pool as an external texture so it outlives this graph.
+static FRDGTextureRef RegisterPersistentVolumeTexture(
+    FRDGBuilder& GraphBuilder,
+    TRefCountPtr<IPooledRenderTarget>& PooledTexture,
+    const FRDGTextureDesc& Desc,
+    const TCHAR* Name)
+{
+    if (PooledTexture.IsValid())
+    {
+        const FRHITextureDesc& PooledDesc = PooledTexture->GetRHI()->GetDesc();
+        if (PooledDesc.Format == Desc.Format && PooledDesc.GetSize() == Desc.GetSize())
+        {
+            return GraphBuilder.RegisterExternalTexture(PooledTexture, Name);
+        }
+    }
+    FRDGTextureRef Texture = GraphBuilder.CreateTexture(Desc, Name);
+    PooledTexture = GraphBuilder.ConvertToExternalTexture(Texture);
+    return Texture;
+}
+
+// Registers the SDF textures of the last completed build, which may predate the current DataVersion
+static FVoxelRenderTextureResult RegisterBuiltVoxelRenderTextures(FRDGBuilder& GraphBuilder, const FVoxelRenderResource& Resource, const FVoxelSdfBuildSettings& Settings)
+{
+    FVoxelRenderTextureResult Outputs;
+    Outputs.VolumeDimensions = Resource.BuiltDimensions;
+    Outputs.DensityTex = GraphBuilder.RegisterExternalTexture(Resource.DensityTexture, TEXT("Voxel.Density"));
+    if (Settings.bNarrowBand)
+    {
+        Outputs.SdfAtlasTex       = GraphBuilder.RegisterExternalTexture(Resource.SdfAtlasTexture, TEXT("Voxel.SdfAtlas"));
+        Outputs.SdfIndirectionTex = GraphBuilder.RegisterExternalTexture(Resource.SdfIndirectionTexture, TEXT("Voxel.SdfIndirection"));
+        // Taken from the texture rather than SdfBrickCapacity, which may already have grown for the pending rebuild
+        Outputs.SdfAtlasBricks    = Resource.SdfAtlasTexture->GetDesc().GetSize() / GVoxelSdfBrickStored;
+    }
+    else
+    {
+        Outputs.SdfTex    = GraphBuilder.RegisterExternalTexture(Resource.SdfTexture, TEXT("Voxel.SDF"));
+        Outputs.SdfMinTex = GraphBuilder.RegisterExternalTexture(Resource.SdfMinTexture, TEXT("Voxel.SdfMin"));
+    }
+    if (Settings.bNormalVolume)
+    {
+        Outputs.NormalTex = GraphBuilder.RegisterExternalTexture(Resource.NormalTexture, TEXT("Voxel.Normal"));
+    }
+    return Outputs;
+}
+
+// Region a pending rebuild has to cover. Local edits (FVoxelRenderResource::SdfDirtyBox) are rebuilt in a
+// sub-volume: the dirty box plus Margin cells has its distances rewritten, and the sub-volume adds another Margin
+// so every surface near those cells is seen. Anything else, or an edit touching most of the volume, is a full
+// rebuild. Narrow-band SDFs keep no dense SDF to update and always rebuild fully.
+static FVoxelRebuildRegion GetVoxelRebuildRegion(const FVoxelRenderResource& Resource, const FVoxelSdfBuildSettings& Settings, const FIntVector& VolumeDimensions)
+{
+    const FVoxelRebuildRegion FullRegion = FVoxelRebuildRegion::Full(VolumeDimensions);
+    if (CVarVoxelRegionUpdate.GetValueOnAnyThread() == 0
+        || Settings.bNarrowBand
+        || Resource.bSdfDirtyAll
+        || !Resource.HasDisplayableSdf(VolumeDimensions, Settings.GetKey()))
+    {
+        return FullRegion;
+    }
+
+    const FIntVector DirtyMin = Resource.SdfDirtyBox.Min.ComponentMax(FIntVector::ZeroValue);
+    const FIntVector DirtyMax = Resource.SdfDirtyBox.Max.ComponentMin(VolumeDimensions);
+    if (DirtyMax.X <= DirtyMin.X || DirtyMax.Y <= DirtyMin.Y || DirtyMax.Z <= DirtyMin.Z)
+    {
+        return FullRegion;
+    }
+
+    const int32 Margin = FMath::Max(1, CVarVoxelRegionUpdateMargin.GetValueOnAnyThread());
+    const FIntVector UpdateMin = (DirtyMin - FIntVector(Margin)).ComponentMax(FIntVector::ZeroValue);
+    const FIntVector UpdateMax = (DirtyMax + FIntVector(Margin)).ComponentMin(VolumeDimensions);
+    const FIntVector RegionMin = (UpdateMin - FIntVector(Margin)).ComponentMax(FIntVector::ZeroValue);
+    const FIntVector RegionMax = (UpdateMax + FIntVector(Margin)).ComponentMin(VolumeDimensions);
+
+    FVoxelRebuildRegion Region;
+    Region.Origin    = RegionMin;
+    Region.Size      = RegionMax - RegionMin;
+    Region.UpdateMin = UpdateMin - RegionMin;
+    Region.UpdateMax = UpdateMax - RegionMin;
+    // Seeds sit up to one cell off their cell centre, so surfaces outside the sub-volume are at least Margin away
+    Region.MarginLS  = Margin * Resource.VoxelSizeLS;
+    Region.bPartial  = true;
+
+    // Past half the volume the full schedule is about as cheap and has no seams
+    return Region.GetNumVoxels() * 2 < FullRegion.GetNumVoxels() ? Region : FullRegion;
+}
+
+// Splats every instance into a fixed-point accumulation over Region.Size (a sub-volume is treated as a volume of its
+// own) and resolves its update box into the persistent density and, when given, normal volumes. Returns the
+// accumulation for the distance transform of the same region.
+static FRDGTextureRef AddRegionDensityPasses(FRDGBuilder& GraphBuilder, FVoxelRenderResource& Resource, const FVoxelRebuildRegion& Region, FRDGTextureRef DensityTex, FRDGTextureRef NormalTex)
+{
+    const FVector3f RegionMinLS = Resource.VolumeMinLS + FVector3f(Region.Origin) * Resource.VoxelSizeLS;
+    FRDGTextureDesc DensityAccumDesc = FRDGTextureDesc::Create3D(Region.Size, PF_R32_UINT, FClearValueBinding::None, TexCreate_ShaderResource | TexCreate_UAV);
+    FRDGTextureRef DensityAccumTex = GraphBuilder.CreateTexture(DensityAccumDesc, TEXT("Voxel.DensityAccum"));
+    AddClearUAVPass(GraphBuilder, GraphBuilder.CreateUAV(FRDGTextureUAVDesc(DensityAccumTex, 0)), 0u);
+
+    AddSplatInstancesPass(GraphBuilder, Resource, DensityAccumTex, Region.Origin, Region.Size, RegionMinLS, Resource.VoxelSizeLS);
+    AddDensityResolvePass(GraphBuilder, DensityAccumTex, DensityTex, Region);
+    if (NormalTex)
+    {
+        AddNormalVolumePass(GraphBuilder, DensityAccumTex, NormalTex, Region);
+    }
+    return DensityAccumTex;
+}
+
+static FVoxelDistanceFieldInputs GetDistanceFieldInputs(const FVoxelRenderResource& Resource, const FVoxelSdfBuildSettings& Settings, FRDGTextureRef DensityAccumTex, const FVoxelRebuildRegion& Region)
+{
+    FVoxelDistanceFieldInputs Inputs;
+    Inputs.DensityTex       = DensityAccumTex;
+    Inputs.VolumeDimensions = Region.Size;
+    Inputs.VolumeMinLS      = Resource.VolumeMinLS + FVector3f(Region.Origin) * Resource.VoxelSizeLS;
+    Inputs.VoxelSizeLS      = Resource.VoxelSizeLS;
+    Inputs.Region           = Region;
+    // Packed seeds need every cell coordinate to fit in 10 bits; larger volumes keep the float layout
+    Inputs.bPackedSeeds     = Settings.bPackedSeeds && FMath::Max3(Region.Size.X, Region.Size.Y, Region.Size.Z) <= GVoxelPackedSeedMaxDim;
+    Inputs.bTiled           = CVarVoxelDistanceTransformTiled.GetValueOnAnyThread() != 0;
+    return Inputs;
+}
+
+// Narrow-band SDFs are built tile by tile so that no SDF, seed field or splat accumulation of the whole volume is
+// allocated. Each tile is splatted and distance transformed as a region rebuild of its own, with TileMargin cells of
+// context, into a transient SDF covering the tile's bricks and their one voxel apron. That SDF starts cleared to
+// zero, so cells without a surface within the margin get the margin distance: a lower bound, which keeps the
+// constant bricks conservative for sphere tracing. A single tile covering the volume is a plain full build.
+static void AddNarrowBandSdfPasses(
+    FRDGBuilder& GraphBuilder,
+    FVoxelRenderResource& Resource,
+    const FVoxelSdfBuildSettings& Settings,
+    FRDGTextureRef DensityTex,
+    FRDGTextureRef NormalTex,
+    FRDGTextureRef IndirectionTex,
+    FRDGTextureRef AtlasTex,
+    const FIntVector& AtlasBricks)
+{
+    const FIntVector VolumeDimensions = Resource.GetVolumeDimensions();
+    const int32 TileSizeSetting = CVarVoxelSdfNarrowBandTileSize.GetValueOnAnyThread();
+    const int32 TileSize = TileSizeSetting > 0
+        ? FMath::DivideAndRoundUp(TileSizeSetting, GVoxelSdfBrickSize) * GVoxelSdfBrickSize
+        : FMath::Max3(VolumeDimensions.X, VolumeDimensions.Y, VolumeDimensions.Z);
+    const FIntVector TileCount = DivideCeil3D(VolumeDimensions, TileSize);
+    const bool bSingleTile = TileCount == FIntVector(1);
+    // Brick classification must never see a capped distance, so the margin stays past the band
+    const int32 Margin = FMath::Max(CVarVoxelSdfNarrowBandTileMargin.GetValueOnAnyThread(), FMath::CeilToInt(Settings.NarrowBandWidth) + 1);
+
+    // Surface bricks of all tiles are allocated from one counter
+    FRDGBufferRef CounterBuffer = GraphBuilder.CreateBuffer(FRDGBufferDesc::CreateStructuredDesc(sizeof(uint32), 1), TEXT("Voxel.SdfBrickCounter"));
+    FRDGBufferUAVRef CounterUAV = GraphBuilder.CreateUAV(CounterBuffer);
+    AddClearUAVPass(GraphBuilder, CounterUAV, 0u);
+
+    auto AddNarrowBandTile = [&](const FIntVector& Tile)
+    {
+        const FIntVector TileMin = Tile * TileSize;
+        const FIntVector TileMax = (TileMin + FIntVector(TileSize)).ComponentMin(VolumeDimensions);
+        RDG_EVENT_SCOPE(GraphBuilder, "Voxel.NarrowBandTile (%d,%d,%d)", Tile.X, Tile.Y, Tile.Z);
+
+        // DensityRegion resolves the tile itself; SdfRegion writes the tile plus the brick apron into the tile SDF,
+        // so its origin is the sub-volume's first cell relative to that texture
+        FVoxelRebuildRegion DensityRegion = FVoxelRebuildRegion::Full(VolumeDimensions);
+        FVoxelRebuildRegion SdfRegion = DensityRegion;
+        FIntVector SdfMin = FIntVector::ZeroValue;
+        FIntVector SdfMax = VolumeDimensions;
+        if (!bSingleTile)
+        {
+            SdfMin = (TileMin - FIntVector(1)).ComponentMax(FIntVector::ZeroValue);
+            SdfMax = (TileMax + FIntVector(1)).ComponentMin(VolumeDimensions);
+            const FIntVector RegionMin = (SdfMin - FIntVector(Margin)).ComponentMax(FIntVector::ZeroValue);
+            const FIntVector RegionMax = (SdfMax + FIntVector(Margin)).ComponentMin(VolumeDimensions);
+
+            DensityRegion.Origin    = RegionMin;
+            DensityRegion.Size      = RegionMax - RegionMin;
+            DensityRegion.UpdateMin = TileMin - RegionMin;
+            DensityRegion.UpdateMax = TileMax - RegionMin;
+            DensityRegion.bPartial  = true;
+
+            SdfRegion = DensityRegion;
+            SdfRegion.Origin    = RegionMin - SdfMin;
+            SdfRegion.UpdateMin = SdfMin - RegionMin;
+            SdfRegion.UpdateMax = SdfMax - RegionMin;
+            SdfRegion.MarginLS  = Margin * Resource.VoxelSizeLS;
+        }
+
+        FRDGTextureRef DensityAccumTex = AddRegionDensityPasses(GraphBuilder, Resource, DensityRegion, DensityTex, NormalTex);
+
+        FRDGTextureDesc SdfDesc = FRDGTextureDesc::Create3D(SdfMax - SdfMin, PF_R32_FLOAT, FClearValueBinding::None, TexCreate_ShaderResource | TexCreate_UAV);
+        FRDGTextureRef SdfTex = GraphBuilder.CreateTexture(SdfDesc, TEXT("Voxel.SDF"));
+        if (SdfRegion.bPartial)
+        {
+            AddClearUAVPass(GraphBuilder, GraphBuilder.CreateUAV(FRDGTextureUAVDesc(SdfTex, 0)), FVector4f(0.0f, 0.0f, 0.0f, 0.0f));
+        }
+
+        FVoxelDistanceFieldInputs DistanceFieldInputs = GetDistanceFieldInputs(Resource, Settings, DensityAccumTex, DensityRegion);
+        DistanceFieldInputs.Region = SdfRegion;
+        AddDistanceFieldPasses(GraphBuilder, Settings.DistanceTransform, DistanceFieldInputs, SdfTex);
+
+        AddSdfBrickBuildPass(GraphBuilder, Resource, SdfTex, SdfMin, IndirectionTex, AtlasTex, CounterUAV, VolumeDimensions, AtlasBricks,
+            TileMin / GVoxelSdfBrickSize, GetSdfBrickGridDims(TileMax), Settings.NarrowBandWidth * Resource.VoxelSizeLS);
+    };
+
+    for (int32 TileZ = 0; TileZ < TileCount.Z; ++TileZ){
+        for (int32 TileY = 0; TileY < TileCount.Y; ++TileY){
+            for (int32 TileX = 0; TileX < TileCount.X; ++TileX){
+                AddNarrowBandTile(FIntVector(TileX, TileY, TileZ));
+            }
+        }
+    }
+
+    if (!Resource.SdfBrickCountReadback.IsValid())
+    {
+        Resource.SdfBrickCountReadback = MakeUnique<FRHIGPUBufferReadback>(TEXT("Voxel.SdfBrickCountReadback"));
+        AddEnqueueCopyPass(GraphBuilder, Resource.SdfBrickCountReadback.Get(), CounterBuffer, sizeof(uint32));
+    }
+}
+
+// Fetches the volume's SDF from the GPU cache or rebuilds it. With bAllowRebuild false (deferred by the rebuild
+// budget) a stale SDF keeps being displayed; a volume that was never built, or whose layout changed, has none.
+static FVoxelRenderTextureResult BuildVoxelRenderTextureResult(FRDGBuilder& GraphBuilder, FVoxelRenderResource& Resource, bool bAllowRebuild)
+{
+    if (!Resource.IsValid()) return FVoxelRenderTextureResult{};
+
+    const FIntVector VolumeDimensions = Resource.GetVolumeDimensions();
+    const FVoxelSdfBuildSettings Settings = FVoxelSdfBuildSettings::Get();
+    const uint32 SettingsKey = Settings.GetKey();
+    const FIntVector BrickGridDims = GetSdfBrickGridDims(VolumeDimensions);
+
+    if (Resource.IsGpuCacheValid(VolumeDimensions, SettingsKey))
+    {
+        INC_DWORD_STAT(STAT_VoxelSdfCacheHits);
+        return RegisterBuiltVoxelRenderTextures(GraphBuilder, Resource, Settings);
+    }
+    if (!bAllowRebuild)
+    {
+        INC_DWORD_STAT(STAT_VoxelSdfRebuildsDeferred);
+        return Resource.HasDisplayableSdf(VolumeDimensions, SettingsKey)
+            ? RegisterBuiltVoxelRenderTextures(GraphBuilder, Resource, Settings)
+            : FVoxelRenderTextureResult{};
+    }
+    INC_DWORD_STAT(STAT_VoxelSdfRebuilds);
+
+    FVoxelRenderTextureResult Outputs;
+    Outputs.VolumeDimensions = VolumeDimensions;
+
+    // The raymarcher shades from the resolved float density (and normal) volumes; they stay dense in both SDF layouts,
+    // so a narrow-band volume still holds 2 (+ 4) bytes per cell here next to the atlas
+    FRDGTextureDesc DensityDesc = FRDGTextureDesc::Create3D(VolumeDimensions, PF_R16F, FClearValueBinding::None, TexCreate_ShaderResource | TexCreate_UAV);
+    FRDGTextureRef DensityTex = RegisterPersistentVolumeTexture(GraphBuilder, Resource.DensityTexture, DensityDesc, TEXT("Voxel.Density"));
+    if (Settings.bNormalVolume)
+    {
+        FRDGTextureDesc NormalDesc = FRDGTextureDesc::Create3D(VolumeDimensions, PF_G16R16, FClearValueBinding::None, TexCreate_ShaderResource | TexCreate_UAV);
+        Outputs.NormalTex = RegisterPersistentVolumeTexture(GraphBuilder, Resource.NormalTexture, NormalDesc, TEXT("Voxel.Normal"));
+    }
+    else
+    {
+        Resource.NormalTexture.SafeRelease();
+    }
+
+    if (Settings.bNarrowBand)
+    {
+        const FIntVector AtlasBricks = GetSdfAtlasBricks(Resource.SdfBrickCapacity);
+        FRDGTextureDesc IndirectionDesc = FRDGTextureDesc::Create3D(BrickGridDims, PF_R32_UINT, FClearValueBinding::None, TexCreate_ShaderResource | TexCreate_UAV);
+        FRDGTextureDesc AtlasDesc       = FRDGTextureDesc::Create3D(AtlasBricks * GVoxelSdfBrickStored, PF_R16F, FClearValueBinding::None, TexCreate_ShaderResource | TexCreate_UAV);
+        FRDGTextureRef IndirectionTex = RegisterPersistentVolumeTexture(GraphBuilder, Resource.SdfIndirectionTexture, IndirectionDesc, TEXT("Voxel.SdfIndirection"));
+        FRDGTextureRef AtlasTex       = RegisterPersistentVolumeTexture(GraphBuilder, Resource.SdfAtlasTexture, AtlasDesc, TEXT("Voxel.SdfAtlas"));
+        AddNarrowBandSdfPasses(GraphBuilder, Resource, Settings, DensityTex, Outputs.NormalTex, IndirectionTex, AtlasTex, AtlasBricks);
+        Resource.SdfTexture.SafeRelease();
+        Resource.SdfMinTexture.SafeRelease();
+        Resource.SeedTexture.SafeRelease();
+
+        Outputs.SdfAtlasTex       = AtlasTex;
+        Outputs.SdfIndirectionTex = IndirectionTex;
+        Outputs.SdfAtlasBricks    = AtlasBricks;
+    }
+    else
+    {
+        const FVoxelRebuildRegion Region = GetVoxelRebuildRegion(Resource, Settings, VolumeDimensions);
+        if (Region.bPartial)
+        {
+            INC_DWORD_STAT(STAT_VoxelSdfRegionRebuilds);
+        }
+
+        FRDGTextureDesc SdfDesc = FRDGTextureDesc::Create3D(VolumeDimensions, PF_R32_FLOAT, FClearValueBinding::None, TexCreate_ShaderResource | TexCreate_UAV);
+        FRDGTextureRef SdfTex = RegisterPersistentVolumeTexture(GraphBuilder, Resource.SdfTexture, SdfDesc, TEXT("Voxel.SDF"));
+        FRDGTextureRef DensityAccumTex = AddRegionDensityPasses(GraphBuilder, Resource, Region, DensityTex, Outputs.NormalTex);
+
+        FVoxelDistanceFieldInputs DistanceFieldInputs = GetDistanceFieldInputs(Resource, Settings, DensityAccumTex, Region);
+
+        // Warm starts need the last build's seed field in the same layout (HasDisplayableSdf pins dimensions and
+        // settings) and at least two steps, as the first reads the seed texture the last one writes. Region rebuilds
+        // leave the seed field stale, so the next warm start has to begin from a full build again. Only packed seeds
+        // name their surface cell, which the last step needs to drop carried seeds whose surface is gone.
+        bool bWarmStart = false;
+        if (Settings.bWarmStart && DistanceFieldInputs.bPackedSeeds
+            && !Region.bPartial && !UsesExactEdt(Settings.DistanceTransform, VolumeDimensions))
+        {
+            const int32 FullRebuildInterval = FMath::Max(0, CVarVoxelDistanceTransformWarmStartFullRebuildInterval.GetValueOnAnyThread());
+            bWarmStart = Resource.SeedTexture.IsValid()
+                && FMath::Max3(VolumeDimensions.X, VolumeDimensions.Y, VolumeDimensions.Z) > 1
+                && Resource.HasDisplayableSdf(VolumeDimensions, SettingsKey)
+                && Resource.WarmBuildsSinceFull < uint32(FullRebuildInterval);
+            FRDGTextureRef SeedTex = RegisterPersistentVolumeTexture(GraphBuilder, Resource.SeedTexture, DistanceFieldInputs.GetSeedDesc(), TEXT("Voxel.Seed"));
+            DistanceFieldInputs.PrevSeedTex = bWarmStart ? SeedTex : nullptr;
+            DistanceFieldInputs.KeepSeedTex = SeedTex;
+            Resource.WarmBuildsSinceFull = bWarmStart ? Resource.WarmBuildsSinceFull + 1 : 0;
+        }
+        else
+        {
+            Resource.SeedTexture.SafeRelease();
+        }
+        if (bWarmStart)
+        {
+            INC_DWORD_STAT(STAT_VoxelSdfWarmRebuilds);
+        }
+        AddDistanceFieldPasses(GraphBuilder, Settings.DistanceTransform, DistanceFieldInputs, SdfTex);
+
+        FRDGTextureDesc SdfMinDesc = FRDGTextureDesc::Create3D(BrickGridDims, PF_R32_FLOAT, FClearValueBinding::None, TexCreate_ShaderResource | TexCreate_UAV);
+        FRDGTextureRef SdfMinTex = RegisterPersistentVolumeTexture(GraphBuilder, Resource.SdfMinTexture, SdfMinDesc, TEXT("Voxel.SdfMin"));
+        AddSdfMinReducePass(GraphBuilder, SdfTex, SdfMinTex, VolumeDimensions, Region);
+
+        Resource.SdfAtlasTexture.SafeRelease();
+        Resource.SdfIndirectionTexture.SafeRelease();
+        Outputs.SdfTex    = SdfTex;
+        Outputs.SdfMinTex = SdfMinTex;
+    }
+
+    Resource.BuiltVersion     = Resource.DataVersion;
+    Resource.BuiltSettingsKey = SettingsKey;
+    Resource.BuiltDimensions  = VolumeDimensions;
+    Resource.ClearSdfDirty();
+
+    Outputs.DensityTex = DensityTex;
+    return Outputs;
+}
+
+// Per-frame build stage. The first raymarch view of a graph builds (or fetches from the GPU cache) every volume
+// visible in any view of its family; all views then only look their volumes up here, so split-screen views and
+// proxies sharing a render resource never set up the same build twice. Lives on the graph blackboard because the
+// RDG texture refs are only valid for this graph. Rebuilds are scheduled against r.Voxel.RebuildBudget: pending ones
+// run largest on screen first, and a deferred volume keeps displaying its previous SDF.
+struct FVoxelFrameBuild
+{
+    uint32 FrameNumber = 0;
+    TMap<uint64, FVoxelRenderTextureResult> Results;   // by FVoxelRenderResource::GetBuildKey()
+    TSet<uint64> UsedResults;                          // looked up at least once, for STAT_VoxelSdfSharedBuilds
+
+    const FVoxelRenderTextureResult* Find(const FVoxelRenderResource& Resource)
+    {
+        const uint64 BuildKey = Resource.GetBuildKey();
+        const FVoxelRenderTextureResult* Result = Results.Find(BuildKey);
+        bool bAlreadyUsed = false;
+        if (Result)
+        {
+            UsedResults.Add(BuildKey, &bAlreadyUsed);
+        }
+        if (bAlreadyUsed)
+        {
+            INC_DWORD_STAT(STAT_VoxelSdfSharedBuilds);
+        }
+        return Result;
+    }
+};
+RDG_REGISTER_BLACKBOARD_STRUCT(FVoxelFrameBuild);
+
+static bool IsVoxelProxyVisible(const FVoxelSceneProxy* Proxy, const FSceneView* View)
+{
+    if (!Proxy->IsShown(View)) return false;
+
+    const FBoxSphereBounds Bounds = Proxy->GetBounds();
+    return View->ViewFrustum.IntersectBox(Bounds.Origin, Bounds.BoxExtent);
+}
+
+// A visible volume competing for this frame's rebuild budget
+struct FVoxelBuildCandidate
+{
+    FVoxelRenderResource* Resource = nullptr;
+    float ScreenSize = 0.0f;   // largest over the family views and the proxies sharing the resource
+    int64 NumVoxels  = 0;
+    bool  bPending   = false;
+
+    // Waiting frames age the priority so small or distant volumes are not starved by large animated ones
+    float GetPriority() const
+    {
+        return ScreenSize * float(1 + Resource->RebuildDeferredFrames);
+    }
+};
+
+static FVoxelFrameBuild& GetVoxelFrameBuild(FRDGBuilder& GraphBuilder, const FSceneView* View)
+{
+    const uint32 FrameNumber = View->Family ? View->Family->FrameNumber : 0;
+    FVoxelFrameBuild* FrameBuild = GraphBuilder.Blackboard.GetMutable<FVoxelFrameBuild>();
+    if (FrameBuild && FrameBuild->FrameNumber == FrameNumber)
+    {
+        return *FrameBuild;
+    }
+    if (!FrameBuild)
+    {
+        FrameBuild = &GraphBuilder.Blackboard.Create<FVoxelFrameBuild>();
+    }
+    FrameBuild->FrameNumber = FrameNumber;
+    FrameBuild->Results.Reset();
+    FrameBuild->UsedResults.Reset();
+
+    TArray<const FSceneView*, TInlineAllocator<4>> FamilyViews;
+    if (View->Family)
+    {
+        FamilyViews.Append(View->Family->Views);
+    }
+    FamilyViews.AddUnique(View);
+
+    TArray<FVoxelBuildCandidate> Candidates;
+    TMap<uint32, int32> CandidateIndices;   // by ResourceId
+    for (const FVoxelSceneProxy* Proxy : GetVoxelProxies_RenderThread())
+    {
+        if (!IsVoxelProxyActive_RenderThread(Proxy)) continue;
+
+        const TSharedPtr<FVoxelRenderResource>& Resource = Proxy->GetRenderResources();
+        if (!Resource.IsValid() || !Resource->IsValid()) continue;
+
+        const FBoxSphereBounds Bounds = Proxy->GetBounds();
+        float ScreenSize = -1.0f;
+        for (const FSceneView* FamilyView : FamilyViews)
+        {
+            if (FamilyView && IsVoxelProxyVisible(Proxy, FamilyView))
+            {
+                ScreenSize = FMath::Max(ScreenSize, ComputeBoundsScreenSize(FVector4(Bounds.Origin, 1.0), Bounds.SphereRadius, *FamilyView));
+            }
+        }
+        if (ScreenSize < 0.0f) continue;
+
+        if (const int32* Index = CandidateIndices.Find(Resource->ResourceId))
+        {
+            Candidates[*Index].ScreenSize = FMath::Max(Candidates[*Index].ScreenSize, ScreenSize);
+            continue;
+        }
+        CandidateIndices.Add(Resource->ResourceId, Candidates.Num());
+        Candidates.Add({ Resource.Get(), ScreenSize });
+    }
+
+    const FVoxelSdfBuildSettings Settings = FVoxelSdfBuildSettings::Get();
+    const uint32 SettingsKey = Settings.GetKey();
+    for (FVoxelBuildCandidate& Candidate : Candidates)
+    {
+        FVoxelRenderResource& Resource = *Candidate.Resource;
+        const FIntVector VolumeDimensions = Resource.GetVolumeDimensions();
+        // May dirty the resource on atlas overflow, so it runs before the build key is taken
+        if (Settings.bNarrowBand)
+        {
+            UpdateSdfBrickCapacity(Resource, GetSdfBrickGridDims(VolumeDimensions));
+        }
+        Candidate.bPending  = !Resource.IsGpuCacheValid(VolumeDimensions, SettingsKey);
+        // Region rebuilds are charged for their sub-volume only
+        Candidate.NumVoxels = Candidate.bPending
+            ? GetVoxelRebuildRegion(Resource, Settings, VolumeDimensions).GetNumVoxels()
+            : int64(VolumeDimensions.X) * VolumeDimensions.Y * VolumeDimensions.Z;
+    }
+
+    // Pending rebuilds first, highest priority first; the first one always runs so every volume makes progress
+    Candidates.StableSort([](const FVoxelBuildCandidate& A, const FVoxelBuildCandidate& B)
+    {
+        if (A.bPending != B.bPending) return A.bPending;
+        return A.GetPriority() > B.GetPriority();
+    });
+
+    const int64 Budget = CVarVoxelRebuildBudget.GetValueOnAnyThread();
+    int64 Spent = 0;
+    int32 NumRebuilt = 0;
+
+    RDG_EVENT_SCOPE(GraphBuilder, "Voxel.BuildSdf");
+    for (const FVoxelBuildCandidate& Candidate : Candidates)
+    {
+        FVoxelRenderResource& Resource = *Candidate.Resource;
+        bool bAllowRebuild = true;
+        if (Candidate.bPending)
+        {
+            bAllowRebuild = Budget <= 0 || NumRebuilt == 0 || Spent + Candidate.NumVoxels <= Budget;
+            if (bAllowRebuild)
+            {
+                Spent += Candidate.NumVoxels;
+                ++NumRebuilt;
+                Resource.RebuildDeferredFrames = 0;
+            }
+            else
+            {
+                ++Resource.RebuildDeferredFrames;
+            }
+        }
+        FrameBuild->Results.Add(Resource.GetBuildKey(), BuildVoxelRenderTextureResult(GraphBuilder, Resource, bAllowRebuild));
     }
-    return bPingToPong ? SeedPing : SeedPong;
+    return *FrameBuild;
+}
+
+// Targets shared by every raymarch draw of a view
+struct FVoxelRaymarchTargets
+{
+    FRDGTextureRef Color = nullptr;
+    FRDGTextureRef Depth = nullptr;
+    FRDGTextureRef SceneDepthCopy = nullptr;
+
+    // Temporal ray start only: this frame's hits (MRT1) and last frame's hits reprojected into this frame
+    FRDGTextureRef HitOut = nullptr;
+    FRDGTextureRef TemporalStart = nullptr;
+
+    // Cone prepass only: per-tile world-space start distance, one slice per volume
+    FRDGTextureRef ConeStart = nullptr;
+    int32 ConeTileSize = 0;
+
+    bool UseTemporalStart() const { return HitOut != nullptr; }
+    bool UseConeStart() const { return ConeStart != nullptr; }
+};
+
+struct FVoxelRaymarchBatchItem
+{
+    const FVoxelSceneProxy* Proxy = nullptr;
+    TSharedPtr<FVoxelRenderResource> Resource;
+    FVoxelRenderTextureResult RenderResult;
+    uint32 HistorySlot = 0;   // 1-based slot in the view's temporal history, 0 = none
+    uint32 ConeSlice = 0;     // slice of FVoxelRaymarchTargets::ConeStart
+};
+
+// View constants and the scene depth copy both raymarch pixel shaders reconstruct their rays and depth clamp from
+template<typename ParametersType>
+static void SetVoxelRaymarchViewParameters(ParametersType& Params, const FSceneView* View, const FIntPoint& SceneExtent, FRDGTextureRef SceneDepthCopy)
+{
+    Params.ViewProj        = FMatrix44f(View->ViewMatrices.GetViewProjectionMatrix());
+    Params.InvViewProj     = FMatrix44f(View->ViewMatrices.GetInvViewProjectionMatrix());
+    Params.CameraWorldPos  = static_cast<FVector3f>(View->ViewMatrices.GetViewOrigin());
+    Params.ViewportInvSize = FVector2f(1.0f / static_cast<float>(SceneExtent.X), 1.0f / static_cast<float>(SceneExtent.Y));
+    Params.SceneDepthTex   = SceneDepthCopy;
+}
+
+// Empty space skipping over the coarse min-distance grid (SdfMinTex, or the constant bricks in narrow-band mode)
+// and the step count debug view; both raymarch pixel shaders read them
+template<typename ParametersType>
+static void SetVoxelRaymarchStepParameters(ParametersType& Params)
+{
+    Params.EmptySpaceSkip = CVarVoxelRaymarchEmptySpaceSkip.GetValueOnAnyThread();
+    Params.DebugStepCount = CVarVoxelRaymarchDebugSteps.GetValueOnAnyThread();
 }
 
-static void AddDistanceToSdfPass(
+static void AddVoxelRaymarchProxyPass(
     FRDGBuilder& GraphBuilder,
-    FRDGTextureRef InSeed,
-    FRDGTextureRef OutSdf,
-    const FIntVector& VolumeDimensions,
-    const FVector3f& VolumeMinLS,
-    float VoxelSizeLS,
-    FRDGTextureRef DensityTex)
+    const FVoxelRaymarchTargets& Targets,
+    const FSceneView* View,
+    const FVoxelRaymarchBatchItem& Item)
+{
+    const FVoxelSceneProxy* Proxy = Item.Proxy;
+    const TSharedPtr<FVoxelRenderResource>& Resource = Item.Resource;
+    const FVoxelRenderTextureResult& RenderResult = Item.RenderResult;
+
+    auto* PassParameters = GraphBuilder.AllocParameters<FVoxelRaymarchPassParameters>();
+    PassParameters->SDFTex = RenderResult.SdfTex;
+    PassParameters->SdfMinTex = RenderResult.SdfMinTex;
+    PassParameters->SdfIndirectionTex = RenderResult.SdfIndirectionTex;
+    PassParameters->SdfAtlasTex = RenderResult.SdfAtlasTex;
+    PassParameters->DensityTex = RenderResult.DensityTex;
+    PassParameters->NormalTex = RenderResult.NormalTex;
+    PassParameters->SceneDepthTex = Targets.SceneDepthCopy;
+    PassParameters->TemporalStartTex = Targets.TemporalStart;
+    PassParameters->ConeStartTex = Targets.ConeStart;
+    PassParameters->RenderTargets[0] = FRenderTargetBinding(Targets.Color, ERenderTargetLoadAction::ELoad);
+    if (Targets.UseTemporalStart())
+    {
+        PassParameters->RenderTargets[1] = FRenderTargetBinding(Targets.HitOut, ERenderTargetLoadAction::ELoad);
+    }
+    PassParameters->RenderTargets.DepthStencil = FDepthStencilBinding(
+        Targets.Depth,
+        ERenderTargetLoadAction::ELoad,
+        ERenderTargetLoadAction::ELoad,
+        FExclusiveDepthStencil::DepthWrite_StencilNop);
+
+    const FIntPoint SceneExtent = Targets.Color->Desc.Extent;
+    const FRDGTextureRef SceneDepthCopy = Targets.SceneDepthCopy;
+    const FRDGTextureRef TemporalStart = Targets.TemporalStart;
+    const FRDGTextureRef ConeStart = Targets.ConeStart;
+    const int32 ConeTileSize = Targets.ConeTileSize;
+    const uint32 HistorySlot = Item.HistorySlot;
+    const uint32 ConeSlice = Item.ConeSlice;
+    FVoxelRaymarchQuality Quality = FVoxelRaymarchQuality::Get();
+    if (!RenderResult.NormalTex && Quality.NormalMethod == 2)
+    {
+        Quality.NormalMethod = 0;
+    }
+    GraphBuilder.AddPass(
+        RDG_EVENT_NAME("Voxel.RaymarchRendering"),
+        PassParameters,
+        ERDGPassFlags::Raster,
+        [PassParameters, SceneExtent, View, Proxy, RenderResult, Resource, SceneDepthCopy, TemporalStart, ConeStart, ConeTileSize, HistorySlot, ConeSlice, Quality](FRHICommandListImmediate& RHICmdList)
+        {
+            FGraphicsPipelineStateInitializer GraphicsPSO;
+            RHICmdList.ApplyCachedRenderTargets(GraphicsPSO);
+
+            GraphicsPSO.BlendState        = TStaticBlendState<CW_RGBA, BO_Add, BF_SourceAlpha, BF_InverseSourceAlpha, BO_Add, BF_One, BF_InverseSourceAlpha>::GetRHI();
+            GraphicsPSO.RasterizerState   = TStaticRasterizerState<FM_Solid, CM_None>::GetRHI();
+            GraphicsPSO.DepthStencilState = TStaticDepthStencilState<true, CF_GreaterEqual>::GetRHI();
+            GraphicsPSO.PrimitiveType     = PT_TriangleList;
+
+            ERHIFeatureLevel::Type FeatureLevel = GMaxRHIFeatureLevel;
+            TShaderMapRef<FRaymarchBoundingBoxVS>  VS(GetGlobalShaderMap(FeatureLevel));
+            FRaymarchPS::FPermutationDomain PermutationVector;
+            PermutationVector.Set<FRaymarchPS::FNarrowBandDim>(RenderResult.IsNarrowBand());
+            PermutationVector.Set<FRaymarchPS::FTemporalStartDim>(TemporalStart != nullptr);
+            PermutationVector.Set<FRaymarchPS::FConeStartDim>(ConeStart != nullptr);
+            Quality.SetPermutation(PermutationVector);
+            TShaderMapRef<FRaymarchPS>  PS(GetGlobalShaderMap(FeatureLevel), PermutationVector);
+
+            GraphicsPSO.BoundShaderState.VertexDeclarationRHI = GEmptyVertexDeclaration.VertexDeclarationRHI;
+            GraphicsPSO.BoundShaderState.VertexShaderRHI = VS.GetVertexShader();
+            GraphicsPSO.BoundShaderState.PixelShaderRHI  = PS.GetPixelShader();
+            SetGraphicsPipelineState(RHICmdList, GraphicsPSO, 0);
+
+            RHICmdList.SetViewport(0, 0, 0.0f, SceneExtent.X, SceneExtent.Y, 1.0f);
+
+            const FMatrix LocalToWorld = Proxy->GetLocalToWorld();
+            const FMatrix WorldToLocal = LocalToWorld.InverseFast();
+            const FVector CameraPosLS = WorldToLocal.TransformPosition(View->ViewMatrices.GetViewOrigin());
+
+            FRaymarchBoundingBoxVS::FParameters VSParams;
+            VSParams.VolumeMinLS = Resource->VolumeMinLS;
+            VSParams.VolumeMaxLS = Resource->VolumeMaxLS;
+            VSParams.LocalToClip = FMatrix44f(LocalToWorld * View->ViewMatrices.GetViewProjectionMatrix());
+            VSParams.CameraPosLS = FVector3f(CameraPosLS);
+            SetShaderParameters(RHICmdList, VS, VS.GetVertexShader(), VSParams);
+
+            FRaymarchPS::FParameters PSParams;
+            PSParams.VolumeMinLS = Resource->VolumeMinLS;
+            PSParams.VolumeMaxLS = Resource->VolumeMaxLS;
+            PSParams.VoxelSizeLS = Resource->VoxelSizeLS;
+            PSParams.LocalToWorld = FMatrix44f(LocalToWorld);
+            PSParams.WorldToLocal = FMatrix44f(WorldToLocal);
+            SetVoxelRaymarchViewParameters(PSParams, View, SceneExtent, SceneDepthCopy);
+            PSParams.CameraPosLS = FVector3f(CameraPosLS);
+            PSParams.VolumeDims = RenderResult.VolumeDimensions;
+            SetVoxelRaymarchStepParameters(PSParams);
+            PSParams.HistorySlot = HistorySlot;
+            PSParams.TemporalStartMargin = CVarVoxelRaymarchTemporalStartMargin.GetValueOnAnyThread();
+            PSParams.ConeSlice = ConeSlice;
+            PSParams.ConeTileSize = ConeTileSize;
+            PSParams.SDFTex = RenderResult.SdfTex;
+            PSParams.SdfMinTex = RenderResult.SdfMinTex;
+            PSParams.SdfIndirectionTex = RenderResult.SdfIndirectionTex;
+            PSParams.SdfAtlasTex = RenderResult.SdfAtlasTex;
+            PSParams.SdfAtlasBricks = RenderResult.SdfAtlasBricks;
+            PSParams.SdfAtlasInvSize = FVector3f(1.0f) / FVector3f(RenderResult.SdfAtlasBricks * GVoxelSdfBrickStored).ComponentMax(FVector3f(1.0f));
+            PSParams.DensityTex = RenderResult.DensityTex;
+            PSParams.NormalTex = RenderResult.NormalTex;
+            PSParams.TemporalStartTex = TemporalStart;
+            PSParams.ConeStartTex = ConeStart;
+            PSParams.SDFSampler = TStaticSamplerState<SF_Bilinear, AM_Clamp, AM_Clamp, AM_Clamp>::GetRHI();
+            SetShaderParameters(RHICmdList, PS, PS.GetPixelShader(), PSParams);
+
+            // 12 triangles of the volume box; camera-facing ones are collapsed in the VS
+            RHICmdList.DrawPrimitive(0, 12, 1);
+        });
+}
+
+// The raymarch passes write SceneDepth, so rays are clamped against a copy taken before the first volume draws.
+// Extent is the raymarch target size; at reduced resolution the copy is downsampled conservatively.
+static FRDGTextureRef AddCopySceneDepthPass(FRDGBuilder& GraphBuilder, FRDGTextureRef SceneDepth, const FIntPoint& Extent, int32 Divisor)
 {
-    TShaderMapRef<FDistanceToSdfCS> CS(GetGlobalShaderMap(GMaxRHIFeatureLevel));
-    auto* Params = GraphBuilder.AllocParameters<FDistanceToSdfCS::FParameters>();
-    Params->VolumeDimensions         = VolumeDimensions;
-    Params->VolumeMinLS             = VolumeMinLS;
-    Params->VoxelSizeLS             = VoxelSizeLS;
-    Params->SeedTex                 = InSeed;
-    Params->DensityTex              = DensityTex;
-    Params->SdfUAV                  = GraphBuilder.CreateUAV(FRDGTextureUAVDesc(OutSdf, 0));
-    const FIntVector Groups = DivideCeil3D(VolumeDimensions, 8);
-    FComputeShaderUtils::AddPass(GraphBuilder, RDG_EVENT_NAME("Voxel.DistanceToSDF"), ERDGPassFlags::Compute, CS, Params, Groups);
+    FRDGTextureDesc Desc = FRDGTextureDesc::Create2D(Extent, PF_R32_FLOAT, FClearValueBinding::None, TexCreate_ShaderResource | TexCreate_UAV);
+    FRDGTextureRef SceneDepthCopy = GraphBuilder.CreateTexture(Desc, TEXT("Voxel.SceneDepthCopy"));
+
+    TShaderMapRef<FCopySceneDepthCS> CS(GetGlobalShaderMap(GMaxRHIFeatureLevel));
+    auto* Params = GraphBuilder.AllocParameters<FCopySceneDepthCS::FParameters>();
+    Params->SceneDepthExtent      = Extent;
+    Params->SceneDepthInputExtent = SceneDepth->Desc.Extent;
+    Params->SceneDepthDivisor     = Divisor;
+    Params->SceneDepthInput       = SceneDepth;
+    Params->SceneDepthCopyUAV = GraphBuilder.CreateUAV(SceneDepthCopy);
+    FComputeShaderUtils::AddPass(GraphBuilder, RDG_EVENT_NAME("Voxel.CopySceneDepth"), ERDGPassFlags::Compute, CS, Params, FComputeShaderUtils::GetGroupCount(Extent, 8));
+    return SceneDepthCopy;
 }
 
-struct FVoxelRenderTextureResult
+// Screen rect covered by the batch's world bounds; falls back to the whole target when a box reaches behind the camera
+static FIntRect GetVoxelBatchScissorRect(const FSceneView* View, TConstArrayView<FVoxelRaymarchBatchItem> Items, const FIntPoint& SceneExtent)
 {
-    FRDGTextureRef SdfTex = nullptr;
-    FRDGTextureRef DensityTex = nullptr;
-    FIntVector VolumeDimensions = FIntVector::ZeroValue;
+    const FMatrix ViewProj = View->ViewMatrices.GetViewProjectionMatrix();
+    FVector2D Min(UE_BIG_NUMBER);
+    FVector2D Max(-UE_BIG_NUMBER);
+    for (const FVoxelRaymarchBatchItem& Item : Items)
+    {
+        const FBoxSphereBounds Bounds = Item.Proxy->GetBounds();
+        for (int32 Corner = 0; Corner < 8; ++Corner)
+        {
+            const FVector Sign((Corner & 1) ? 1.0 : -1.0, (Corner & 2) ? 1.0 : -1.0, (Corner & 4) ? 1.0 : -1.0);
+            const FVector4 Clip = ViewProj.TransformPosition(Bounds.Origin + Bounds.BoxExtent * Sign);
+            if (Clip.W <= UE_KINDA_SMALL_NUMBER)
+            {
+                return FIntRect(FIntPoint::ZeroValue, SceneExtent);
+            }
+            const FVector2D Ndc(Clip.X / Clip.W, Clip.Y / Clip.W);
+            const FVector2D Pixel((Ndc.X * 0.5 + 0.5) * SceneExtent.X, (0.5 - Ndc.Y * 0.5) * SceneExtent.Y);
+            Min = FVector2D::Min(Min, Pixel);
+            Max = FVector2D::Max(Max, Pixel);
+        }
+    }
+
+    FIntRect Rect(
+        FIntPoint(FMath::FloorToInt(Min.X), FMath::FloorToInt(Min.Y)),
+        FIntPoint(FMath::CeilToInt(Max.X), FMath::CeilToInt(Max.Y)));
+    Rect.Clip(FIntRect(FIntPoint::ZeroValue, SceneExtent));
+    return Rect;
+}
+
+// One raster pass for up to GVoxelBatchMaxVolumes dense-SDF volumes, scissored to their combined screen rect
+static void AddVoxelRaymarchBatchPass(
+    FRDGBuilder& GraphBuilder,
+    const FVoxelRaymarchTargets& Targets,
+    const FSceneView* View,
+    TConstArrayView<FVoxelRaymarchBatchItem> Items)
+{
+    check(Items.Num() > 0 && Items.Num() <= GVoxelBatchMaxVolumes);
+
+    const FIntPoint SceneExtent = Targets.Color->Desc.Extent;
+    const FIntRect ScissorRect = GetVoxelBatchScissorRect(View, Items, SceneExtent);
+    if (ScissorRect.Area() <= 0) return;
+
+    TArray<FVoxelBatchVolumeGPU> Volumes;
+    Volumes.Reserve(Items.Num());
+    for (const FVoxelRaymarchBatchItem& Item : Items)
+    {
+        const FMatrix LocalToWorld = Item.Proxy->GetLocalToWorld();
+        FVoxelBatchVolumeGPU& Volume = Volumes.AddDefaulted_GetRef();
+        Volume.LocalToWorld = FMatrix44f(LocalToWorld);
+        Volume.WorldToLocal = FMatrix44f(LocalToWorld.InverseFast());
+        Volume.VolumeMinLS  = FVector4f(Item.Resource->VolumeMinLS, Item.Resource->VoxelSizeLS);
+        Volume.VolumeMaxLS  = FVector4f(Item.Resource->VolumeMaxLS, static_cast<float>(Item.ConeSlice));
+        Volume.VolumeDims   = FIntVector4(Item.RenderResult.VolumeDimensions.X, Item.RenderResult.VolumeDimensions.Y, Item.RenderResult.VolumeDimensions.Z, Item.HistorySlot);
+    }
+    FRDGBufferRef VolumesBuffer = CreateStructuredBuffer(GraphBuilder, TEXT("Voxel.RaymarchBatchVolumes"), Volumes);
+
+    auto* PassParameters = GraphBuilder.AllocParameters<FRaymarchBatchedPS::FParameters>();
+    PassParameters->NumBatchVolumes = Items.Num();
+    SetVoxelRaymarchViewParameters(*PassParameters, View, SceneExtent, Targets.SceneDepthCopy);
+    PassParameters->BatchVolumes    = GraphBuilder.CreateSRV(VolumesBuffer);
+    SetVoxelRaymarchStepParameters(*PassParameters);
+    PassParameters->TemporalStartMargin = CVarVoxelRaymarchTemporalStartMargin.GetValueOnAnyThread();
+    PassParameters->ConeTileSize    = Targets.ConeTileSize;
+
+    FVoxelRaymarchQuality Quality = FVoxelRaymarchQuality::Get();
+
+    // Unused slots repeat the first volume so every binding is valid
+    FRDGTextureRef SdfSlots[GVoxelBatchMaxVolumes];
+    FRDGTextureRef SdfMinSlots[GVoxelBatchMaxVolumes];
+    FRDGTextureRef DensitySlots[GVoxelBatchMaxVolumes];
+    FRDGTextureRef NormalSlots[GVoxelBatchMaxVolumes];
+    bool bAllNormalVolumes = true;
+    for (int32 Slot = 0; Slot < GVoxelBatchMaxVolumes; ++Slot)
+    {
+        const FVoxelRenderTextureResult& Result = Items[Items.IsValidIndex(Slot) ? Slot : 0].RenderResult;
+        SdfSlots[Slot]     = Result.SdfTex;
+        SdfMinSlots[Slot]  = Result.SdfMinTex;
+        DensitySlots[Slot] = Result.DensityTex;
+        NormalSlots[Slot]  = Result.NormalTex;
+        bAllNormalVolumes &= Result.NormalTex != nullptr;
+    }
+    PassParameters->SDFTex0 = SdfSlots[0]; PassParameters->SdfMinTex0 = SdfMinSlots[0]; PassParameters->DensityTex0 = DensitySlots[0]; PassParameters->NormalTex0 = NormalSlots[0];
+    PassParameters->SDFTex1 = SdfSlots[1]; PassParameters->SdfMinTex1 = SdfMinSlots[1]; PassParameters->DensityTex1 = DensitySlots[1]; PassParameters->NormalTex1 = NormalSlots[1];
+    PassParameters->SDFTex2 = SdfSlots[2]; PassParameters->SdfMinTex2 = SdfMinSlots[2]; PassParameters->DensityTex2 = DensitySlots[2]; PassParameters->NormalTex2 = NormalSlots[2];
+    PassParameters->SDFTex3 = SdfSlots[3]; PassParameters->SdfMinTex3 = SdfMinSlots[3]; PassParameters->DensityTex3 = DensitySlots[3]; PassParameters->NormalTex3 = NormalSlots[3];
+    PassParameters->SDFTex4 = SdfSlots[4]; PassParameters->SdfMinTex4 = SdfMinSlots[4]; PassParameters->DensityTex4 = DensitySlots[4]; PassParameters->NormalTex4 = NormalSlots[4];
+    PassParameters->SDFTex5 = SdfSlots[5]; PassParameters->SdfMinTex5 = SdfMinSlots[5]; PassParameters->DensityTex5 = DensitySlots[5]; PassParameters->NormalTex5 = NormalSlots[5];
+    PassParameters->SDFTex6 = SdfSlots[6]; PassParameters->SdfMinTex6 = SdfMinSlots[6]; PassParameters->DensityTex6 = DensitySlots[6]; PassParameters->NormalTex6 = NormalSlots[6];
+    PassParameters->SDFTex7 = SdfSlots[7]; PassParameters->SdfMinTex7 = SdfMinSlots[7]; PassParameters->DensityTex7 = DensitySlots[7]; PassParameters->NormalTex7 = NormalSlots[7];
+    if (!bAllNormalVolumes && Quality.NormalMethod == 2)
+    {
+        Quality.NormalMethod = 0;
+    }
+    PassParameters->TemporalStartTex = Targets.TemporalStart;
+    PassParameters->ConeStartTex = Targets.ConeStart;
+    PassParameters->SDFSampler = TStaticSamplerState<SF_Bilinear, AM_Clamp, AM_Clamp, AM_Clamp>::GetRHI();
+    PassParameters->RenderTargets[0] = FRenderTargetBinding(Targets.Color, ERenderTargetLoadAction::ELoad);
+    if (Targets.UseTemporalStart())
+    {
+        PassParameters->RenderTargets[1] = FRenderTargetBinding(Targets.HitOut, ERenderTargetLoadAction::ELoad);
+    }
+    PassParameters->RenderTargets.DepthStencil = FDepthStencilBinding(
+        Targets.Depth,
+        ERenderTargetLoadAction::ELoad,
+        ERenderTargetLoadAction::ELoad,
+        FExclusiveDepthStencil::DepthWrite_StencilNop);
+
+    GraphBuilder.AddPass(
+        RDG_EVENT_NAME("Voxel.RaymarchRendering (batched, %d volumes)", Items.Num()),
+        PassParameters,
+        ERDGPassFlags::Raster,
+        [PassParameters, SceneExtent, ScissorRect, bTemporalStart = Targets.UseTemporalStart(), bConeStart = Targets.UseConeStart(), Quality](FRHICommandListImmediate& RHICmdList)
+        {
+            FGraphicsPipelineStateInitializer GraphicsPSO;
+            RHICmdList.ApplyCachedRenderTargets(GraphicsPSO);
+
+            GraphicsPSO.BlendState        = TStaticBlendState<CW_RGBA, BO_Add, BF_SourceAlpha, BF_InverseSourceAlpha, BO_Add, BF_One, BF_InverseSourceAlpha>::GetRHI();
+            GraphicsPSO.RasterizerState   = TStaticRasterizerState<FM_Solid, CM_None>::GetRHI();
+            GraphicsPSO.DepthStencilState = TStaticDepthStencilState<true, CF_GreaterEqual>::GetRHI();
+            GraphicsPSO.PrimitiveType     = PT_TriangleList;
+
+            ERHIFeatureLevel::Type FeatureLevel = GMaxRHIFeatureLevel;
+            TShaderMapRef<FRaymarchFullscreenVS> VS(GetGlobalShaderMap(FeatureLevel));
+            FRaymarchBatchedPS::FPermutationDomain PermutationVector;
+            PermutationVector.Set<FRaymarchBatchedPS::FTemporalStartDim>(bTemporalStart);
+            PermutationVector.Set<FRaymarchBatchedPS::FConeStartDim>(bConeStart);
+            Quality.SetPermutation(PermutationVector);
+            TShaderMapRef<FRaymarchBatchedPS>    PS(GetGlobalShaderMap(FeatureLevel), PermutationVector);
+
+            GraphicsPSO.BoundShaderState.VertexDeclarationRHI = GEmptyVertexDeclaration.VertexDeclarationRHI;
+            GraphicsPSO.BoundShaderState.VertexShaderRHI = VS.GetVertexShader();
+            GraphicsPSO.BoundShaderState.PixelShaderRHI  = PS.GetPixelShader();
+            SetGraphicsPipelineState(RHICmdList, GraphicsPSO, 0);
+
+            RHICmdList.SetViewport(0, 0, 0.0f, SceneExtent.X, SceneExtent.Y, 1.0f);
+            RHICmdList.SetScissorRect(true, ScissorRect.Min.X, ScissorRect.Min.Y, ScissorRect.Max.X, ScissorRect.Max.Y);
+
+            FRaymarchFullscreenVS::FParameters VSParams;
+            SetShaderParameters(RHICmdList, VS, VS.GetVertexShader(), VSParams);
+            SetShaderParameters(RHICmdList, PS, PS.GetPixelShader(), *PassParameters);
+
+            RHICmdList.DrawPrimitive(0, 1, 1);
+            RHICmdList.SetScissorRect(false, 0, 0, 0, 0);
+        });
+}
+
+static int32 GetVoxelRaymarchResolutionDivisor()
+{
+    const int32 Divisor = CVarVoxelRaymarchResolutionDivisor.GetValueOnAnyThread();
+    return Divisor >= 4 ? 4 : (Divisor >= 2 ? 2 : 1);
+}
+
+// Reduced-resolution raymarch targets, cleared to no coverage / far depth
+struct FVoxelLowResTargets
+{
+    FRDGTextureRef Color = nullptr;
+    FRDGTextureRef Depth = nullptr;
 };
 
-static FVoxelRenderTextureResult BuildVoxelRenderTextureResult(FRDGBuilder& GraphBuilder, const FVoxelRenderResource& Resource)
+static FVoxelLowResTargets CreateVoxelLowResTargets(FRDGBuilder& GraphBuilder, const FIntPoint& SceneExtent, int32 Divisor)
 {
-    if (!Resource.IsValid()) return FVoxelRenderTextureResult{};
+    const FIntPoint Extent = FIntPoint::DivideAndRoundUp(SceneExtent, Divisor);
+
+    FVoxelLowResTargets Targets;
+    Targets.Color = GraphBuilder.CreateTexture(
+        FRDGTextureDesc::Create2D(Extent, PF_FloatRGBA, FClearValueBinding::Transparent, TexCreate_RenderTargetable | TexCreate_ShaderResource),
+        TEXT("Voxel.LowResColor"));
+    Targets.Depth = GraphBuilder.CreateTexture(
+        FRDGTextureDesc::Create2D(Extent, PF_DepthStencil, FClearValueBinding::DepthFar, TexCreate_DepthStencilTargetable | TexCreate_ShaderResource),
+        TEXT("Voxel.LowResDepth"));
+    AddClearRenderTargetPass(GraphBuilder, Targets.Color, FLinearColor::Transparent);
+    AddClearDepthStencilPass(GraphBuilder, Targets.Depth, true, 0.0f, false, 0);
+    return Targets;
+}
 
-    const FVector3f VolumeMinLS = Resource.VolumeMinLS;
-    const FVector3f VolumeMaxLS = Resource.VolumeMaxLS;
-    const float VoxelSizeLS = Resource.VoxelSizeLS;
-    const FVector3f ExtentLS = (VolumeMaxLS - VolumeMinLS);
-    const int32 NX = FMath::Max(1, FMath::RoundToInt(ExtentLS.X / VoxelSizeLS));
-    const int32 NY = FMath::Max(1, FMath::RoundToInt(ExtentLS.Y / VoxelSizeLS));
-    const int32 NZ = FMath::Max(1, FMath::RoundToInt(ExtentLS.Z / VoxelSizeLS));
-    const FIntVector VolumeDimensions(NX, NY, NZ);
-
-    FRDGTextureDesc DensityDesc = FRDGTextureDesc::Create3D(VolumeDimensions, PF_R32_UINT, FClearValueBinding::None, TexCreate_ShaderResource | TexCreate_UAV);
-    FRDGTextureDesc SeedDesc    = FRDGTextureDesc::Create3D(VolumeDimensions, PF_A32B32G32R32F, FClearValueBinding::None, TexCreate_ShaderResource | TexCreate_UAV);
-    FRDGTextureDesc SdfDesc     = FRDGTextureDesc::Create3D(VolumeDimensions, PF_R32_FLOAT, FClearValueBinding::None, TexCreate_ShaderResource | TexCreate_UAV);
-
-    FRDGTextureRef DensityTex = GraphBuilder.CreateTexture(DensityDesc, TEXT("Voxel.Density"));
-    FRDGTextureRef SeedPing   = GraphBuilder.CreateTexture(SeedDesc,    TEXT("Voxel.SeedPing"));
-    FRDGTextureRef SeedPong   = GraphBuilder.CreateTexture(SeedDesc,    TEXT("Voxel.SeedPong"));
-    FRDGTextureRef SdfTex     = GraphBuilder.CreateTexture(SdfDesc,     TEXT("Voxel.SDF"));
-
-    FRDGTextureUAVRef DensityUAV = GraphBuilder.CreateUAV(FRDGTextureUAVDesc(DensityTex, 0));
-    AddClearUAVPass(GraphBuilder, DensityUAV, 0u);
-    FRDGTextureUAVRef SdfUAV = GraphBuilder.CreateUAV(FRDGTextureUAVDesc(SdfTex, 0));
-    AddClearUAVPass(GraphBuilder, SdfUAV, 0.0f);
-    
-    AddSplatInstancesPass(GraphBuilder, Resource, DensityTex, VolumeDimensions, VolumeMinLS, VoxelSizeLS);
-    AddSeedPass(GraphBuilder, DensityTex, SeedPing, VolumeDimensions, VoxelSizeLS);
-    FRDGTextureRef SeedAll = AddJFAPasses(GraphBuilder, SeedPing, SeedPong, VolumeDimensions);
-    AddDistanceToSdfPass(GraphBuilder, SeedAll, SdfTex, VolumeDimensions, VolumeMinLS, VoxelSizeLS, DensityTex);
+static void AddVoxelUpsampleCompositePass(
+    FRDGBuilder& GraphBuilder,
+    FRDGTextureRef SceneColor,
+    FRDGTextureRef SceneDepth,
+    const FVoxelLowResTargets& LowRes,
+    const FSceneView* View,
+    int32 Divisor)
+{
+    auto* PassParameters = GraphBuilder.AllocParameters<FVoxelUpsampleCompositePS::FParameters>();
+    PassParameters->LowResExtent      = LowRes.Color->Desc.Extent;
+    PassParameters->ResolutionDivisor = static_cast<float>(Divisor);
+    PassParameters->InvDeviceZToWorldZTransform = FVector4f(View->InvDeviceZToWorldZTransform);
+    PassParameters->LowResColorTex    = LowRes.Color;
+    PassParameters->LowResDepthTex    = LowRes.Depth;
+    PassParameters->RenderTargets[0]  = FRenderTargetBinding(SceneColor, ERenderTargetLoadAction::ELoad);
+    PassParameters->RenderTargets.DepthStencil = FDepthStencilBinding(
+        SceneDepth,
+        ERenderTargetLoadAction::ELoad,
+        ERenderTargetLoadAction::ELoad,
+        FExclusiveDepthStencil::DepthWrite_StencilNop);
 
-    FVoxelRenderTextureResult Outputs;
-    Outputs.SdfTex = SdfTex;
-    Outputs.DensityTex = DensityTex;
-    Outputs.VolumeDimensions = VolumeDimensions;
-    return Outputs;
+    const FIntPoint SceneExtent = SceneColor->Desc.Extent;
+    GraphBuilder.AddPass(
+        RDG_EVENT_NAME("Voxel.UpsampleComposite 1/%d", Divisor),
+        PassParameters,
+        ERDGPassFlags::Raster,
+        [PassParameters, SceneExtent](FRHICommandListImmediate& RHICmdList)
+        {
+            FGraphicsPipelineStateInitializer GraphicsPSO;
+            RHICmdList.ApplyCachedRenderTargets(GraphicsPSO);
+
+            GraphicsPSO.BlendState        = TStaticBlendState<CW_RGBA, BO_Add, BF_SourceAlpha, BF_InverseSourceAlpha, BO_Add, BF_One, BF_InverseSourceAlpha>::GetRHI();
+            GraphicsPSO.RasterizerState   = TStaticRasterizerState<FM_Solid, CM_None>::GetRHI();
+            GraphicsPSO.DepthStencilState = TStaticDepthStencilState<true, CF_GreaterEqual>::GetRHI();
+            GraphicsPSO.PrimitiveType     = PT_TriangleList;
+
+            ERHIFeatureLevel::Type FeatureLevel = GMaxRHIFeatureLevel;
+            TShaderMapRef<FRaymarchFullscreenVS>     VS(GetGlobalShaderMap(FeatureLevel));
+            TShaderMapRef<FVoxelUpsampleCompositePS> PS(GetGlobalShaderMap(FeatureLevel));
+
+            GraphicsPSO.BoundShaderState.VertexDeclarationRHI = GEmptyVertexDeclaration.VertexDeclarationRHI;
+            GraphicsPSO.BoundShaderState.VertexShaderRHI = VS.GetVertexShader();
+            GraphicsPSO.BoundShaderState.PixelShaderRHI  = PS.GetPixelShader();
+            SetGraphicsPipelineState(RHICmdList, GraphicsPSO, 0);
+
+            RHICmdList.SetViewport(0, 0, 0.0f, SceneExtent.X, SceneExtent.Y, 1.0f);
+            FRaymarchFullscreenVS::FParameters VSParams;
+            SetShaderParameters(RHICmdList, VS, VS.GetVertexShader(), VSParams);
+            SetShaderParameters(RHICmdList, PS, PS.GetPixelShader(), *PassParameters);
+
+            RHICmdList.DrawPrimitive(0, 1, 1);
+        });
+}
+
+// ========= Cone prepass =========
+// One thread per screen tile marches a cone that encloses every pixel ray of the tile through the volume's SDF. The
+// world distance it reaches is free of surface for all of those rays, so the raymarch starts them there.
+
+static int32 GetVoxelConePrepassTileSize()
+{
+    return CVarVoxelRaymarchConePrepassTileSize.GetValueOnAnyThread() >= 16 ? 16 : 8;
+}
+
+static void CreateVoxelConeStartTexture(FRDGBuilder& GraphBuilder, FVoxelRaymarchTargets& Targets, int32 NumVolumes)
+{
+    Targets.ConeTileSize = GetVoxelConePrepassTileSize();
+    const FIntPoint TileCount = FIntPoint::DivideAndRoundUp(Targets.Color->Desc.Extent, Targets.ConeTileSize);
+    Targets.ConeStart = GraphBuilder.CreateTexture(
+        FRDGTextureDesc::Create2DArray(TileCount, PF_R32_FLOAT, FClearValueBinding::None, TexCreate_ShaderResource | TexCreate_UAV, NumVolumes),
+        TEXT("Voxel.ConeStart"));
+    // Tiles outside a volume's screen rect are never marched; 0 leaves their rays at the box entry
+    AddClearUAVPass(GraphBuilder, GraphBuilder.CreateUAV(Targets.ConeStart), 0.0f);
+}
+
+static void AddVoxelConePrepass(
+    FRDGBuilder& GraphBuilder,
+    const FVoxelRaymarchTargets& Targets,
+    const FSceneView* View,
+    const FVoxelRaymarchBatchItem& Item)
+{
+    const FIntPoint Extent = Targets.Color->Desc.Extent;
+    const FIntRect ScreenRect = GetVoxelBatchScissorRect(View, MakeArrayView(&Item, 1), Extent);
+    if (ScreenRect.Area() <= 0) return;
+
+    const FIntPoint TileMin = ScreenRect.Min / Targets.ConeTileSize;
+    const FIntPoint TileMax = FIntPoint::DivideAndRoundUp(ScreenRect.Max, Targets.ConeTileSize);
+
+    const FVoxelRenderResource& Resource = *Item.Resource;
+    const FVoxelRenderTextureResult& RenderResult = Item.RenderResult;
+    const FMatrix LocalToWorld = Item.Proxy->GetLocalToWorld();
+
+    FRaymarchConePrepassCS::FPermutationDomain PermutationVector;
+    PermutationVector.Set<FRaymarchConePrepassCS::FNarrowBandDim>(RenderResult.IsNarrowBand());
+    TShaderMapRef<FRaymarchConePrepassCS> CS(GetGlobalShaderMap(GMaxRHIFeatureLevel), PermutationVector);
+
+    auto* Params = GraphBuilder.AllocParameters<FRaymarchConePrepassCS::FParameters>();
+    Params->VolumeMinLS      = Resource.VolumeMinLS;
+    Params->VolumeMaxLS      = Resource.VolumeMaxLS;
+    Params->VoxelSizeLS      = Resource.VoxelSizeLS;
+    Params->WorldToLocal     = FMatrix44f(LocalToWorld.InverseFast());
+    Params->InvViewProj      = FMatrix44f(View->ViewMatrices.GetInvViewProjectionMatrix());
+    Params->CameraWorldPos   = static_cast<FVector3f>(View->ViewMatrices.GetViewOrigin());
+    Params->ViewportInvSize  = FVector2f(1.0f / static_cast<float>(Extent.X), 1.0f / static_cast<float>(Extent.Y));
+    Params->VolumeDims       = RenderResult.VolumeDimensions;
+    Params->SdfAtlasBricks   = RenderResult.SdfAtlasBricks;
+    Params->SdfAtlasInvSize  = FVector3f(1.0f) / FVector3f(RenderResult.SdfAtlasBricks * GVoxelSdfBrickStored).ComponentMax(FVector3f(1.0f));
+    // A local distance bound shrinks by the smallest axis scale in world space
+    Params->MinWorldPerLocal = static_cast<float>(LocalToWorld.GetScaleVector().GetMin());
+    Params->ConeTileMin      = TileMin;
+    Params->ConeTileMax      = TileMax;
+    Params->ConeTileSize     = Targets.ConeTileSize;
+    Params->ConeSlice        = Item.ConeSlice;
+    Params->SDFTex           = RenderResult.SdfTex;
+    Params->SdfIndirectionTex = RenderResult.SdfIndirectionTex;
+    Params->SdfAtlasTex      = RenderResult.SdfAtlasTex;
+    Params->DensityTex       = RenderResult.DensityTex;
+    Params->SDFSampler       = TStaticSamplerState<SF_Bilinear, AM_Clamp, AM_Clamp, AM_Clamp>::GetRHI();
+    Params->ConeStartUAV     = GraphBuilder.CreateUAV(Targets.ConeStart);
+
+    FComputeShaderUtils::AddPass(
+        GraphBuilder,
+        RDG_EVENT_NAME("Voxel.ConePrepass %dx%d tiles", TileMax.X - TileMin.X, TileMax.Y - TileMin.Y),
+        ERDGPassFlags::Compute,
+        CS,
+        Params,
+        FComputeShaderUtils::GetGroupCount(TileMax - TileMin, 8));
+}
+
+// ========= Temporal ray start =========
+// Per-view history of last frame's hits. Hits are kept in the local space of the volume they belong to, so
+// reprojection needs only that volume's current transform; volumes are identified by (PrimitiveId, ResourceId,
+// BuiltVersion): the primitive keeps placements of the same UVoxelVolume apart, and the version drops the history of a
+// volume as soon as the SDF it displays is rebuilt (a rebuild deferred by the budget keeps it).
+
+struct FVoxelHistoryVolume
+{
+    uint32 PrimitiveId  = 0;
+    uint32 ResourceId   = 0;
+    uint32 BuiltVersion = 0;
+
+    bool operator==(const FVoxelHistoryVolume& Other) const
+    {
+        return PrimitiveId == Other.PrimitiveId && ResourceId == Other.ResourceId && BuiltVersion == Other.BuiltVersion;
+    }
+};
+
+struct FVoxelRaymarchHistory
+{
+    TRefCountPtr<IPooledRenderTarget> HitTexture;   // xyz = local-space hit, w = history slot (0 = no hit)
+    TArray<FVoxelHistoryVolume> SlotVolumes;        // history slot - 1 -> volume
+    uint32 LastFrameNumber = 0;
+};
+
+// The start texture packs the slot into 8 bits
+static constexpr int32 GVoxelMaxHistorySlots = 255;
+static constexpr uint32 GVoxelHistoryMaxAgeFrames = 60;
+
+// Keyed by view state; values are heap-allocated because queued extractions hold on to HitTexture until the graph runs
+static TMap<uint32, TUniquePtr<FVoxelRaymarchHistory>> GVoxelRaymarchHistories;
+
+static FVoxelRaymarchHistory* FindOrAddVoxelRaymarchHistory(const FSceneView* View)
+{
+    if (!View->State || !View->Family) return nullptr;
+
+    const uint32 FrameNumber = View->Family->FrameNumber;
+    for (auto It = GVoxelRaymarchHistories.CreateIterator(); It; ++It)
+    {
+        if (FrameNumber - It.Value()->LastFrameNumber > GVoxelHistoryMaxAgeFrames)
+        {
+            It.RemoveCurrent();
+        }
+    }
+
+    TUniquePtr<FVoxelRaymarchHistory>& History = GVoxelRaymarchHistories.FindOrAdd(View->State->GetViewKey());
+    if (!History.IsValid())
+    {
+        History = MakeUnique<FVoxelRaymarchHistory>();
+    }
+    History->LastFrameNumber = FrameNumber;
+    return History.Get();
+}
+
+// Creates this frame's hit target and the start texture, scatters the usable part of the history into the latter and
+// assigns the items their history slots for this frame
+static void AddVoxelTemporalStartPasses(
+    FRDGBuilder& GraphBuilder,
+    const FSceneView* View,
+    FVoxelRaymarchHistory& History,
+    TArrayView<FVoxelRaymarchBatchItem> Items,
+    FVoxelRaymarchTargets& Targets)
+{
+    const FIntPoint Extent = Targets.Color->Desc.Extent;
+
+    Targets.HitOut = GraphBuilder.CreateTexture(
+        FRDGTextureDesc::Create2D(Extent, PF_A32B32G32R32F, FClearValueBinding::Transparent, TexCreate_RenderTargetable | TexCreate_ShaderResource),
+        TEXT("Voxel.RaymarchHits"));
+    AddClearRenderTargetPass(GraphBuilder, Targets.HitOut, FLinearColor::Transparent);
+
+    Targets.TemporalStart = GraphBuilder.CreateTexture(
+        FRDGTextureDesc::Create2D(Extent, PF_R32_UINT, FClearValueBinding::None, TexCreate_ShaderResource | TexCreate_UAV),
+        TEXT("Voxel.TemporalStart"));
+    FRDGTextureUAVRef TemporalStartUAV = GraphBuilder.CreateUAV(Targets.TemporalStart);
+    AddClearUAVPass(GraphBuilder, TemporalStartUAV, MAX_uint32);
+
+    TArray<FVoxelHistoryVolume> SlotVolumes;
+    for (int32 Index = 0; Index < Items.Num() && Index < GVoxelMaxHistorySlots; ++Index)
+    {
+        Items[Index].HistorySlot = Index + 1;
+        SlotVolumes.Add({ Items[Index].Proxy->GetPrimitiveComponentId().PrimIDValue, Items[Index].Resource->ResourceId, Items[Index].Resource->BuiltVersion });
+    }
+
+    // Map last frame's slots onto this frame's volumes
+    TArray<FVoxelTemporalRecordGPU> Records;
+    Records.SetNum(History.SlotVolumes.Num());
+    bool bAnyRecord = false;
+    for (int32 PrevSlot = 0; PrevSlot < History.SlotVolumes.Num(); ++PrevSlot)
+    {
+        const FVoxelHistoryVolume& PrevVolume = History.SlotVolumes[PrevSlot];
+        for (int32 Slot = 0; Slot < SlotVolumes.Num(); ++Slot)
+        {
+            if (SlotVolumes[Slot] == PrevVolume)
+            {
+                Records[PrevSlot].LocalToWorld = FMatrix44f(Items[Slot].Proxy->GetLocalToWorld());
+                Records[PrevSlot].CurrentSlot  = Slot + 1;
+                bAnyRecord = true;
+                break;
+            }
+        }
+    }
+
+    // A resized target invalidates the whole history
+    if (bAnyRecord && History.HitTexture.IsValid() && History.HitTexture->GetDesc().Extent == Extent)
+    {
+        TShaderMapRef<FVoxelTemporalScatterCS> CS(GetGlobalShaderMap(GMaxRHIFeatureLevel));
+        auto* Params = GraphBuilder.AllocParameters<FVoxelTemporalScatterCS::FParameters>();
+        Params->ViewProj           = FMatrix44f(View->ViewMatrices.GetViewProjectionMatrix());
+        Params->CameraWorldPos     = static_cast<FVector3f>(View->ViewMatrices.GetViewOrigin());
+        Params->TemporalExtent     = Extent;
+        Params->NumTemporalRecords = Records.Num();
+        Params->TemporalRecords    = GraphBuilder.CreateSRV(CreateStructuredBuffer(GraphBuilder, TEXT("Voxel.TemporalRecords"), Records));
+        Params->HistoryHitTex      = GraphBuilder.RegisterExternalTexture(History.HitTexture, TEXT("Voxel.RaymarchHitsHistory"));
+        Params->TemporalStartUAV   = TemporalStartUAV;
+        FComputeShaderUtils::AddPass(GraphBuilder, RDG_EVENT_NAME("Voxel.TemporalScatter"), ERDGPassFlags::Compute, CS, Params, FComputeShaderUtils::GetGroupCount(Extent, 8));
+    }
+
+    History.SlotVolumes = MoveTemp(SlotVolumes);
 }
 
 void AddVoxelRaymarchPass(
@@ -357,80 +2591,88 @@ void AddVoxelRaymarchPass(
     const FSceneView* View = static_cast<const FSceneView*>(OpaqueView);
     if (!View) return;
 
+    const bool bBatched = CVarVoxelRaymarchBatched.GetValueOnAnyThread() != 0;
+    const int32 Divisor = GetVoxelRaymarchResolutionDivisor();
+
+    FVoxelFrameBuild& FrameBuild = GetVoxelFrameBuild(GraphBuilder, View);
+
+    TArray<FVoxelRaymarchBatchItem> Items;
     const auto& Proxies = GetVoxelProxies_RenderThread();
     for (const FVoxelSceneProxy* Proxy : Proxies)
     {
         if (!IsVoxelProxyActive_RenderThread(Proxy)) continue;
-        if (!Proxy->IsShown(View)) continue;
-        
-        const FBoxSphereBounds Bounds = Proxy->GetBounds();
-        if (!View->ViewFrustum.IntersectBox(Bounds.Origin, Bounds.BoxExtent)) continue;
+        if (!IsVoxelProxyVisible(Proxy, View)) continue;
 
         const TSharedPtr<FVoxelRenderResource>& Resource = Proxy->GetRenderResources();
         if (!Resource.IsValid()) continue;
 
-        const FVoxelRenderTextureResult RenderResult = BuildVoxelRenderTextureResult(GraphBuilder, *Resource.Get());
-        if (!RenderResult.SdfTex) continue;
-
-        auto* PassParameters = GraphBuilder.AllocParameters<FVoxelRaymarchPassParameters>();
-        PassParameters->SDFTex = RenderResult.SdfTex;
-        PassParameters->DensityTex = RenderResult.DensityTex;
-        PassParameters->RenderTargets[0] = FRenderTargetBinding(SceneColor, ERenderTargetLoadAction::ELoad);
-        PassParameters->RenderTargets.DepthStencil = FDepthStencilBinding(
-            SceneDepth,
-            ERenderTargetLoadAction::ELoad,
-            ERenderTargetLoadAction::ELoad,
-            FExclusiveDepthStencil::DepthWrite_StencilNop);
-
-        const FIntPoint SceneExtent = SceneColor->Desc.Extent;
-        GraphBuilder.AddPass(
-            RDG_EVENT_NAME("Voxel.RaymarchRendering"),
-            PassParameters,
-            ERDGPassFlags::Raster,
-            [PassParameters, SceneExtent, View, Proxy, RenderResult, Resource, SceneDepth](FRHICommandListImmediate& RHICmdList)
-            {
-                FGraphicsPipelineStateInitializer GraphicsPSO;
-                RHICmdList.ApplyCachedRenderTargets(GraphicsPSO);
-
-                GraphicsPSO.BlendState        = TStaticBlendState<CW_RGBA, BO_Add, BF_SourceAlpha, BF_InverseSourceAlpha, BO_Add, BF_One, BF_InverseSourceAlpha>::GetRHI();
-                GraphicsPSO.RasterizerState   = TStaticRasterizerState<FM_Solid, CM_None>::GetRHI();
-                GraphicsPSO.DepthStencilState = TStaticDepthStencilState<true, CF_GreaterEqual>::GetRHI();
-                GraphicsPSO.PrimitiveType     = PT_TriangleList;
-
-                ERHIFeatureLevel::Type FeatureLevel = GMaxRHIFeatureLevel;
-                TShaderMapRef<FRaymarchFullscreenVS>  VS(GetGlobalShaderMap(FeatureLevel));
-                TShaderMapRef<FRaymarchPS>  PS(GetGlobalShaderMap(FeatureLevel));
-
-                GraphicsPSO.BoundShaderState.VertexDeclarationRHI = GEmptyVertexDeclaration.VertexDeclarationRHI;
-                GraphicsPSO.BoundShaderState.VertexShaderRHI = VS.GetVertexShader();
-                GraphicsPSO.BoundShaderState.PixelShaderRHI  = PS.GetPixelShader();
-                SetGraphicsPipelineState(RHICmdList, GraphicsPSO, 0);
-
-                RHICmdList.SetViewport(0, 0, 0.0f, SceneExtent.X, SceneExtent.Y, 1.0f);
-                FRaymarchFullscreenVS::FParameters VSParams;
-                SetShaderParameters(RHICmdList, VS, VS.GetVertexShader(), VSParams);
-
-                FRaymarchPS::FParameters PSParams;
-                PSParams.VolumeMinLS = Resource->VolumeMinLS;
-                PSParams.VolumeMaxLS = Resource->VolumeMaxLS;
-                PSParams.VoxelSizeLS = Resource->VoxelSizeLS;
-                const FMatrix LocalToWorld = Proxy->GetLocalToWorld();
-                const FMatrix WorldToLocal = LocalToWorld.InverseFast();
-                PSParams.LocalToWorld = FMatrix44f(LocalToWorld);
-                PSParams.WorldToLocal = FMatrix44f(WorldToLocal);
-                PSParams.InvViewProj = FMatrix44f(View->ViewMatrices.GetInvViewProjectionMatrix());
-                PSParams.ViewProj    = FMatrix44f(View->ViewMatrices.GetViewProjectionMatrix());
-                PSParams.CameraWorldPos = static_cast<FVector3f>(View->ViewMatrices.GetViewOrigin());
-                PSParams.ViewportInvSize = FVector2f(1.0f / static_cast<float>(SceneExtent.X), 1.0f / static_cast<float>(SceneExtent.Y));
-                PSParams.ViewportMin = FVector2f(0.0f, 0.0f);
-                PSParams.VolumeDims = RenderResult.VolumeDimensions;
-                PSParams.SDFTex = RenderResult.SdfTex;
-                PSParams.DensityTex = RenderResult.DensityTex;
-                PSParams.SDFSampler = TStaticSamplerState<SF_Bilinear, AM_Clamp, AM_Clamp, AM_Clamp>::GetRHI();
-                SetShaderParameters(RHICmdList, PS, PS.GetPixelShader(), PSParams);
-
-                RHICmdList.DrawPrimitive(0, 1, 1);
-            });
+        const FVoxelRenderTextureResult* RenderResult = FrameBuild.Find(*Resource.Get());
+        if (!RenderResult || !RenderResult->HasSdf()) continue;
+
+        FVoxelRaymarchBatchItem& Item = Items.Add_GetRef({ Proxy, Resource, *RenderResult });
+        Item.ConeSlice = Items.Num() - 1;
+    }
+    if (Items.IsEmpty()) return;
+
+    // The volumes raymarch into the scene targets or low-res ones that are composited afterwards
+    FVoxelRaymarchTargets Targets;
+    Targets.Color = SceneColor;
+    Targets.Depth = SceneDepth;
+    FVoxelLowResTargets LowRes;
+    if (Divisor > 1)
+    {
+        LowRes = CreateVoxelLowResTargets(GraphBuilder, SceneColor->Desc.Extent, Divisor);
+        Targets.Color = LowRes.Color;
+        Targets.Depth = LowRes.Depth;
+    }
+    Targets.SceneDepthCopy = AddCopySceneDepthPass(GraphBuilder, SceneDepth, Targets.Color->Desc.Extent, Divisor);
+
+    if (CVarVoxelRaymarchConePrepass.GetValueOnAnyThread() != 0)
+    {
+        CreateVoxelConeStartTexture(GraphBuilder, Targets, Items.Num());
+        for (const FVoxelRaymarchBatchItem& Item : Items)
+        {
+            AddVoxelConePrepass(GraphBuilder, Targets, View, Item);
+        }
+    }
+
+    FVoxelRaymarchHistory* History = CVarVoxelRaymarchTemporalStart.GetValueOnAnyThread() != 0 ? FindOrAddVoxelRaymarchHistory(View) : nullptr;
+    if (History)
+    {
+        AddVoxelTemporalStartPasses(GraphBuilder, View, *History, Items, Targets);
+    }
+
+    TArray<FVoxelRaymarchBatchItem, TInlineAllocator<GVoxelBatchMaxVolumes>> Batch;
+    for (const FVoxelRaymarchBatchItem& Item : Items)
+    {
+        // Narrow-band volumes need the indirection/atlas pair and keep their own pass
+        if (!bBatched || Item.RenderResult.IsNarrowBand())
+        {
+            AddVoxelRaymarchProxyPass(GraphBuilder, Targets, View, Item);
+            continue;
+        }
+
+        Batch.Add(Item);
+        if (Batch.Num() == GVoxelBatchMaxVolumes)
+        {
+            AddVoxelRaymarchBatchPass(GraphBuilder, Targets, View, Batch);
+            Batch.Reset();
+        }
+    }
+
+    if (Batch.Num() > 0)
+    {
+        AddVoxelRaymarchBatchPass(GraphBuilder, Targets, View, Batch);
+    }
+
+    if (History)
+    {
+        GraphBuilder.QueueTextureExtraction(Targets.HitOut, &History->HitTexture);
+    }
+
+    if (LowRes.Color)
+    {
+        AddVoxelUpsampleCompositePass(GraphBuilder, SceneColor, SceneDepth, LowRes, View, Divisor);
     }
 }
 
@@ -103,21 +103,15 @@ FVoxelSceneProxy::FVoxelSceneProxy(const UVoxelRenderComponent* InComponent)
 {
     VolumeRenderResources = InComponent->GetSharedRenderResources();
 
-    TArray<FVector3f> CentersCopy;
-    TArray<float>     ScalesCopy;
-    if (VolumeRenderResources.IsValid())
-    {
-        CentersCopy = VolumeRenderResources->Centers;
-        ScalesCopy  = VolumeRenderResources->Scales;
-    }
-
+    // Bricks is owned by the render thread (grid builds and edits are applied by render commands), so the debug
+    // mesh is built from it there rather than copied here
     ENQUEUE_RENDER_COMMAND(RegisterVoxelProxyCmd)(
-        [This = this, CentersCopy = MoveTemp(CentersCopy), ScalesCopy = MoveTemp(ScalesCopy)](FRHICommandListImmediate& RHICmdList)
+        [This = this](FRHICommandListImmediate& RHICmdList)
         {
             RegisterProxy_RenderThread(This);
-            if (CentersCopy.Num() > 0)
+            if (This->VolumeRenderResources.IsValid())
             {
-                This->BuildDebugMesh_RenderThread(RHICmdList, CentersCopy, ScalesCopy);
+                This->RebuildDebugMesh_RenderThread(RHICmdList, *This->VolumeRenderResources);
             }
         });
 }
@@ -170,18 +164,17 @@ void FVoxelSceneProxy::GetDynamicMeshElements(const TArray<const FSceneView*>& V
 void FVoxelSceneProxy::RebuildDebugMesh_RenderThread(FRHICommandListImmediate& RHICmdList, const FVoxelRenderResource& Resource)
 {
     check(IsInRenderingThread());
-    if (Resource.Centers.Num() == 0)
+    if (Resource.Bricks.IsEmpty())
     {
         DebugMesh.Reset();
         return;
     }
-    BuildDebugMesh_RenderThread(RHICmdList, Resource.Centers, Resource.Scales);
+    BuildDebugMesh_RenderThread(RHICmdList, Resource.Bricks);
 }
 
 void FVoxelSceneProxy::BuildDebugMesh_RenderThread(
     FRHICommandListImmediate& RHICmdList,
-    const TArray<FVector3f>& Centers,
-    const TArray<float>& Scales)
+    const FVoxelBrickMap& Bricks)
 {
     check(IsInRenderingThread());
 
@@ -193,8 +186,8 @@ void FVoxelSceneProxy::BuildDebugMesh_RenderThread(
 
     TArray<FVector3f> Positions;
     TArray<uint32>    Indices;
-    Positions.Reserve(Centers.Num() * 8);
-    Indices.Reserve(Centers.Num() * 36);
+    Positions.Reserve(Bricks.NumOccupiedCells() * 8);
+    Indices.Reserve(Bricks.NumOccupiedCells() * 36);
 
     auto AppendCube = [](float Half, const FVector3f& C, TArray<FVector3f>& P, TArray<uint32>& I)
     {
@@ -215,12 +208,12 @@ void FVoxelSceneProxy::BuildDebugMesh_RenderThread(
         for (uint32 k = 0; k < UE_ARRAY_COUNT(Idx); ++k) { I.Add(Base + Idx[k]); }
     };
 
-    for (int32 i = 0; i < Centers.Num(); ++i)
+    Bricks.ForEachOccupiedCell([&](const FIntVector& Cell, int32 AtlasIndex)
     {
-        const float Edge = Scales.IsValidIndex(i) ? Scales[i] * VolumeRenderResources->VoxelSizeLS: VolumeRenderResources->VoxelSizeLS;
+        const float Edge = Bricks.Scales[AtlasIndex] * VolumeRenderResources->VoxelSizeLS;
         const float Half = Edge * 0.5f;
-        AppendCube(Half, Centers[i], Positions, Indices);
-    }
+        AppendCube(Half, Bricks.Centers[AtlasIndex], Positions, Indices);
+    });
 
     DebugMesh.Reset();
     const uint32 VBSize = Positions.Num() * sizeof(FVector3f);
@@ -3,37 +3,50 @@
 #include "RHI.h"
 #include "RHICommandList.h"
 
-static void AddVoxelInstance(const FVector3f& Center, float DefaultScale,
-                             TArray<FVector3f>& OutCenters,
-                             TArray<float>& OutScales)
+static void AddVoxelInstance(const FIntVector& Cell, const FVector3f& Center, float DefaultScale,
+                             FVoxelBrickMap& OutBricks)
 {
-    OutCenters.Add(Center);
-    OutScales.Add(DefaultScale);
+    OutBricks.SetCell(Cell, Center, DefaultScale);
 }
 
 static void InitInstances_RenderThread(
     FVoxelRenderResource& Out,
-    const TArray<FVector3f>& Centers,
-    const TArray<float>& Scales,
+    FVoxelBrickMap&& Bricks,
     FRHICommandListImmediate& RHICmdList)
 {
     Out.ReleaseAll();
-    Out.InitializeInstances(Centers, Scales);
+    Out.InitializeBricks(MoveTemp(Bricks));
+    Out.SplatReachCells = GetVoxelSplatReachCells(1.0f);
 }
 
-void UVoxelVolume::BuildVoxelGrid(const FVector& RegionSize, float BlockSize)
+// Linear index in the original dense build order, used to keep per-instance animation phases stable
+static int32 GetLinearCellIndex(const FIntVector& Cell, const FIntVector& GridDims)
+{
+    return (Cell.X * GridDims.Y + Cell.Y) * GridDims.Z + Cell.Z;
+}
+
+void UVoxelVolume::BuildVoxelGrid(const FVector& RegionSize, float BlockSize, bool bForceRebuild)
 {
     if (BlockSize <= 0.f)
     {
         return;
     }
+    if (!bForceRebuild && RenderResources.IsValid() && !BaseBricks_GT.IsEmpty()
+        && BuiltRegionSize_GT == RegionSize && BuiltBlockSize_GT == BlockSize)
+    {
+        return;
+    }
     if (!RenderResources.IsValid())
     {
         RenderResources = MakeShared<FVoxelRenderResource>();
     }
+    BuiltRegionSize_GT = RegionSize;
+    BuiltBlockSize_GT  = BlockSize;
+    LastScaleAnim_GT   = FVector3f(-1.0f);
+    LastCenterAnim_GT  = FVector3f(-1.0f);
+    MaxCenterOffset_GT = 0.0f;
 
-    TArray<FVector3f>  CentersArr;
-    TArray<float>      ScalesArr;
+    FVoxelBrickMap Bricks;
 
     const FVector3f Region = (FVector3f)RegionSize;
 
@@ -54,15 +67,12 @@ void UVoxelVolume::BuildVoxelGrid(const FVector& RegionSize, float BlockSize)
         -PackedLenY * 0.5f + Half,
         -PackedLenZ * 0.5f + Half);
 
-    CentersArr.Reserve(NX * NY * NZ);
-    ScalesArr.Reserve(NX * NY * NZ);
-
     for (int32 ix = 0; ix < NX; ++ix){
         for (int32 iy = 0; iy < NY; ++iy){
             for (int32 iz = 0; iz < NZ; ++iz){
                 const FVector3f Center = Start + FVector3f(ix * BlockSize, iy * BlockSize, iz * BlockSize);
                 // スケールは正規化（0..1）。初期値は全て1に設定
-                AddVoxelInstance(Center, 1.0f, CentersArr, ScalesArr);
+                AddVoxelInstance(FIntVector(ix, iy, iz), Center, 1.0f, Bricks);
             }
         }
     }
@@ -71,15 +81,15 @@ void UVoxelVolume::BuildVoxelGrid(const FVector& RegionSize, float BlockSize)
     RenderResources->VolumeMaxLS = VolumeMaxLS;
     RenderResources->VoxelSizeLS = BlockSize;
 
-    // Cache base arrays on GT for runtime animation
-    BaseCenters_GT = CentersArr;
-    BaseScales_GT  = ScalesArr;
+    // Cache base layout on GT for runtime animation
+    BaseBricks_GT = Bricks;
+    GridDims_GT   = FIntVector(NX, NY, NZ);
 
     ENQUEUE_RENDER_COMMAND(InitVoxelVolumeGridBuffersCmd)(
-        [Shared = RenderResources, CentersCopy = MoveTemp(CentersArr), ScalesCopy = MoveTemp(ScalesArr)](FRHICommandListImmediate& RHICmdList)
+        [Shared = RenderResources, BricksCopy = MoveTemp(Bricks)](FRHICommandListImmediate& RHICmdList) mutable
         {
             if (!Shared.IsValid()) return;
-            InitInstances_RenderThread(*Shared.Get(), CentersCopy, ScalesCopy, RHICmdList);
+            InitInstances_RenderThread(*Shared.Get(), MoveTemp(BricksCopy), RHICmdList);
 
             const auto& Proxies = GetVoxelProxies_RenderThread();
             for (FVoxelSceneProxy* Proxy : Proxies)
@@ -110,33 +120,37 @@ void UVoxelVolume::BeginDestroy()
             });
         RenderResources.Reset();
     }
-    BaseCenters_GT.Reset();
-    BaseScales_GT.Reset();
+    BaseBricks_GT.Reset();
+    BuiltRegionSize_GT = FVector::ZeroVector;
+    BuiltBlockSize_GT  = 0.0f;
 }
 
 void UVoxelVolume::AnimateScales(float TimeSeconds, float Amplitude, float Frequency)
 {
     if (!RenderResources.IsValid()) return;
-    if (BaseScales_GT.Num() == 0) return;
-    const int32 N = BaseScales_GT.Num();
-    TArray<float> NewScales; NewScales.SetNumUninitialized(N);
+    if (BaseBricks_GT.IsEmpty()) return;
+    const FVector3f AnimKey(TimeSeconds, Amplitude, Frequency);
+    if (AnimKey == LastScaleAnim_GT) return;
+    LastScaleAnim_GT = AnimKey;
+    // Unoccupied atlas cells keep their zero scale
+    TArray<float> NewScales = BaseBricks_GT.Scales;
     const float TwoPiF = 6.28318530718f * Frequency;
-    for (int32 i = 0; i < N; ++i)
+    BaseBricks_GT.ForEachOccupiedCell([&](const FIntVector& Cell, int32 AtlasIndex)
     {
-        const float s0 = BaseScales_GT[i];
-        const float phase = (float)i * 0.13f; // simple per-index phase
+        const float s0 = BaseBricks_GT.Scales[AtlasIndex];
+        const float phase = (float)GetLinearCellIndex(Cell, GridDims_GT) * 0.13f; // simple per-index phase
         // 0..1 の正規化スケール（中心0.5、振幅0.5）
         const float t01 = 0.5f + 0.5f * FMath::Sin(TwoPiF * TimeSeconds + phase);
-        NewScales[i] = s0 * t01;
-    }
+        NewScales[AtlasIndex] = s0 * t01;
+    });
     // Render threadに安全に反映
     TSharedPtr<FVoxelRenderResource> Shared = RenderResources;
     ENQUEUE_RENDER_COMMAND(UpdateVoxelScalesCmd)(
-        [Shared, NewScales = MoveTemp(NewScales)](FRHICommandListImmediate&)
+        [Shared, NewScales = MoveTemp(NewScales)](FRHICommandListImmediate&) mutable
         {
             if (Shared.IsValid())
             {
-                Shared->Scales = NewScales;
+                Shared->UpdateScales(MoveTemp(NewScales));
             }
         });
 }
@@ -144,30 +158,112 @@ void UVoxelVolume::AnimateScales(float TimeSeconds, float Amplitude, float Frequ
 void UVoxelVolume::AnimateCenters(float TimeSeconds, float Amplitude, float Frequency)
 {
     if (!RenderResources.IsValid()) return;
-    if (BaseCenters_GT.Num() == 0) return;
-    const int32 N = BaseCenters_GT.Num();
-    TArray<FVector3f> NewCenters; NewCenters.SetNumUninitialized(N);
+    if (BaseBricks_GT.IsEmpty()) return;
+    const FVector3f AnimKey(TimeSeconds, Amplitude, Frequency);
+    if (AnimKey == LastCenterAnim_GT) return;
+    LastCenterAnim_GT = AnimKey;
+    MaxCenterOffset_GT = FMath::Max(MaxCenterOffset_GT, FMath::Abs(Amplitude));
+    TArray<FVector3f> NewCenters = BaseBricks_GT.Centers;
     const float TwoPiF = 6.28318530718f * Frequency;
-    for (int32 i = 0; i < N; ++i)
+    BaseBricks_GT.ForEachOccupiedCell([&](const FIntVector& Cell, int32 AtlasIndex)
     {
-        const FVector3f c0 = BaseCenters_GT[i];
-        const float phase = (float)i * 0.19f;
+        const FVector3f c0 = BaseBricks_GT.Centers[AtlasIndex];
+        const float phase = (float)GetLinearCellIndex(Cell, GridDims_GT) * 0.19f;
         const float w = TwoPiF * TimeSeconds + phase;
         // small Lissajous offset per cell (kept modest to avoid exiting volume)
         const FVector3f offset(
             Amplitude * FMath::Sin(w),
             Amplitude * FMath::Sin(1.37f * w + 0.5f),
             Amplitude * FMath::Sin(1.91f * w + 1.0f));
-        NewCenters[i] = c0 + offset;
-    }
+        NewCenters[AtlasIndex] = c0 + offset;
+    });
+    const int32 SplatReach = GetVoxelSplatReachCells(1.0f)
+        + FMath::CeilToInt(MaxCenterOffset_GT / FMath::Max(RenderResources->VoxelSizeLS, UE_KINDA_SMALL_NUMBER));
     // Render threadに安全に反映
     TSharedPtr<FVoxelRenderResource> Shared = RenderResources;
     ENQUEUE_RENDER_COMMAND(UpdateVoxelCentersCmd)(
-        [Shared, NewCenters = MoveTemp(NewCenters)](FRHICommandListImmediate&)
+        [Shared, NewCenters = MoveTemp(NewCenters), SplatReach](FRHICommandListImmediate&) mutable
         {
             if (Shared.IsValid())
             {
-                Shared->Centers = NewCenters;
+                Shared->UpdateCenters(MoveTemp(NewCenters));
+                Shared->SplatReachCells = SplatReach;
+            }
+        });
+}
+
+void UVoxelVolume::CarveSphere(const FVector& CenterLS, float RadiusLS)
+{
+    CarveSpheres({ CenterLS }, RadiusLS);
+}
+
+void UVoxelVolume::CarveSpheres(const TArray<FVector>& CentersLS, float RadiusLS)
+{
+    if (!RenderResources.IsValid()) return;
+    if (BaseBricks_GT.IsEmpty() || RadiusLS <= 0.f) return;
+
+    const FVector3f VolumeMinLS = RenderResources->VolumeMinLS;
+    const float VoxelSizeLS = FMath::Max(RenderResources->VoxelSizeLS, UE_KINDA_SMALL_NUMBER);
+    // Instances sit wherever AnimateCenters last moved them on the render thread
+    const int32 OffsetCells = FMath::CeilToInt(MaxCenterOffset_GT / VoxelSizeLS);
+    const float RadiusSq = RadiusLS * RadiusLS;
+
+    FVoxelDirtyBox DirtyBox;
+    TArray<FIntVector> Carved;
+    for (const FVector& CenterLS : CentersLS)
+    {
+        const FVector3f Center = (FVector3f)CenterLS;
+        const FVector3f MinCell = (Center - FVector3f(RadiusLS) - VolumeMinLS) / VoxelSizeLS;
+        const FVector3f MaxCell = (Center + FVector3f(RadiusLS) - VolumeMinLS) / VoxelSizeLS;
+        const FIntVector Lo(
+            FMath::Max(0, FMath::FloorToInt(MinCell.X)),
+            FMath::Max(0, FMath::FloorToInt(MinCell.Y)),
+            FMath::Max(0, FMath::FloorToInt(MinCell.Z)));
+        const FIntVector Hi(
+            FMath::Min(GridDims_GT.X - 1, FMath::FloorToInt(MaxCell.X)),
+            FMath::Min(GridDims_GT.Y - 1, FMath::FloorToInt(MaxCell.Y)),
+            FMath::Min(GridDims_GT.Z - 1, FMath::FloorToInt(MaxCell.Z)));
+
+        for (int32 ix = Lo.X; ix <= Hi.X; ++ix){
+            for (int32 iy = Lo.Y; iy <= Hi.Y; ++iy){
+                for (int32 iz = Lo.Z; iz <= Hi.Z; ++iz){
+                    const FIntVector Cell(ix, iy, iz);
+                    if (!BaseBricks_GT.IsCellOccupied(Cell)) continue;
+
+                    const int32 AtlasIndex = BaseBricks_GT.FindAtlasIndex(Cell);
+                    const float Scale = BaseBricks_GT.Scales[AtlasIndex];
+                    const FVector3f InstanceCenter = BaseBricks_GT.Centers[AtlasIndex];
+                    if (FVector3f::DistSquared(InstanceCenter, Center) > RadiusSq) continue;
+
+                    // Every cell the instance's splat can reach, from any position it may have been animated to
+                    const FVector3f Rel = (InstanceCenter - VolumeMinLS) / VoxelSizeLS;
+                    const FIntVector BaseCell(FMath::FloorToInt(Rel.X), FMath::FloorToInt(Rel.Y), FMath::FloorToInt(Rel.Z));
+                    const int32 Reach = GetVoxelSplatReachCells(Scale) + OffsetCells;
+                    DirtyBox.Add({ BaseCell - FIntVector(Reach), BaseCell + FIntVector(Reach + 1) });
+                    Carved.Add(Cell);
+                    BaseBricks_GT.ClearCell(Cell);
+                }
+            }
+        }
+    }
+    if (DirtyBox.IsEmpty()) return;
+
+    // Only the carved cells are sent: the render thread may hold animated values for the rest. Both brick maps free
+    // the same cells in the same order, so emptied bricks release the same atlas slots and the layouts stay in step
+    // for AnimateScales/AnimateCenters, which only walk the cells still occupied in the base layout
+    TSharedPtr<FVoxelRenderResource> Shared = RenderResources;
+    ENQUEUE_RENDER_COMMAND(CarveVoxelInstancesCmd)(
+        [Shared, Carved = MoveTemp(Carved), DirtyBox](FRHICommandListImmediate& RHICmdList)
+        {
+            if (!Shared.IsValid()) return;
+            Shared->ClearCells(Carved, DirtyBox);
+
+            for (FVoxelSceneProxy* Proxy : GetVoxelProxies_RenderThread())
+            {
+                if (Proxy && Proxy->GetRenderResources() == Shared)
+                {
+                    Proxy->RebuildDebugMesh_RenderThread(RHICmdList, *Shared.Get());
+                }
             }
         });
 }
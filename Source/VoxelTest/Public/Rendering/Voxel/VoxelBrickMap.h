@@ -0,0 +1,89 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Sparse voxel instance storage.
+// Cells are grouped into 8^3 bricks that are only allocated once a cell inside them is occupied.
+// A hashed brick map resolves brick coordinates to atlas slots; per-cell payload lives in flat,
+// slot-major arrays (Slot * CellsPerBrick + LocalIndex) so they can be uploaded verbatim as the GPU brick atlas.
+struct FVoxelBrickMap
+{
+    static constexpr int32 BrickShift    = 3;
+    static constexpr int32 BrickSize     = 1 << BrickShift;
+    static constexpr int32 BrickMask     = BrickSize - 1;
+    static constexpr int32 CellsPerBrick = BrickSize * BrickSize * BrickSize;
+    static constexpr int32 OccupancyWordsPerBrick = CellsPerBrick / 64;
+
+    // Atlas payload (slot-major). Unoccupied cells keep Scale = 0 so GPU passes can skip them.
+    TArray<FVector3f> Centers;
+    TArray<float>     Scales;
+
+    // Slot -> brick coordinate (W = 1 while the slot is allocated). Doubles as the GPU indirection table.
+    TArray<FIntVector4> BrickCoords;
+
+    static FIntVector CellToBrick(const FIntVector& Cell)
+    {
+        return FIntVector(Cell.X >> BrickShift, Cell.Y >> BrickShift, Cell.Z >> BrickShift);
+    }
+
+    static int32 CellToLocalIndex(const FIntVector& Cell)
+    {
+        return (Cell.X & BrickMask) | ((Cell.Y & BrickMask) << BrickShift) | ((Cell.Z & BrickMask) << (2 * BrickShift));
+    }
+
+    static FIntVector LocalIndexToOffset(int32 LocalIndex)
+    {
+        return FIntVector(LocalIndex & BrickMask, (LocalIndex >> BrickShift) & BrickMask, LocalIndex >> (2 * BrickShift));
+    }
+
+    int32 NumBricks() const { return BrickToSlot.Num(); }
+    int32 NumSlots() const { return BrickCoords.Num(); }
+    int32 NumAtlasCells() const { return Scales.Num(); }
+    int32 NumOccupiedCells() const { return OccupiedCellCount; }
+    bool  IsEmpty() const { return OccupiedCellCount == 0; }
+
+    void Reset();
+
+    // Random access. Returns the atlas index of the cell, or INDEX_NONE if its brick is not allocated.
+    int32 FindAtlasIndex(const FIntVector& Cell) const;
+    bool  IsCellOccupied(const FIntVector& Cell) const;
+    bool  FindCell(const FIntVector& Cell, FVector3f& OutCenter, float& OutScale) const;
+
+    // Occupies the cell (allocating its brick on demand) and returns its atlas index
+    int32 SetCell(const FIntVector& Cell, const FVector3f& Center, float Scale);
+    // Frees the cell; the brick slot is recycled once its last cell is cleared
+    void  ClearCell(const FIntVector& Cell);
+
+    // Func(const FIntVector& Cell, int32 AtlasIndex)
+    template<typename FuncType>
+    void ForEachOccupiedCell(FuncType&& Func) const
+    {
+        for (int32 Slot = 0; Slot < BrickCoords.Num(); ++Slot)
+        {
+            if (BrickCoords[Slot].W == 0) continue;
+            const FIntVector BrickOrigin = FIntVector(BrickCoords[Slot].X, BrickCoords[Slot].Y, BrickCoords[Slot].Z) * BrickSize;
+            for (int32 Word = 0; Word < OccupancyWordsPerBrick; ++Word)
+            {
+                uint64 Bits = Occupancy[Slot * OccupancyWordsPerBrick + Word];
+                while (Bits != 0)
+                {
+                    const int32 Bit = static_cast<int32>(FMath::CountTrailingZeros64(Bits));
+                    Bits &= Bits - 1;
+                    const int32 LocalIndex = Word * 64 + Bit;
+                    Func(BrickOrigin + LocalIndexToOffset(LocalIndex), Slot * CellsPerBrick + LocalIndex);
+                }
+            }
+        }
+    }
+
+    SIZE_T GetAllocatedSize() const;
+
+private:
+    int32 AllocateSlot(const FIntVector& BrickCoord);
+
+    TMap<FIntVector, int32> BrickToSlot;
+    TArray<uint64>          Occupancy;      // OccupancyWordsPerBrick words per slot
+    TArray<uint16>          SlotCellCounts;
+    TArray<int32>           FreeSlots;
+    int32                   OccupiedCellCount = 0;
+};
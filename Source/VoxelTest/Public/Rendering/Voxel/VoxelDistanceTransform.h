@@ -0,0 +1,32 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// CPU reference for the GPU distance transforms in VoxelDistanceField.usf.
+// Sites and outputs are dense X-major arrays (X + Dims.X * (Y + Dims.Y * Z)); distances are squared, in cells,
+// and negative where the volume contains no site.
+
+// Packed seed layout shared with VoxelDistanceField.usf: surface cell 10:10:10, all bits set = no seed
+static constexpr int32  GVoxelPackedSeedMaxDim  = 1 << 10;
+static constexpr uint32 GVoxelPackedSeedInvalid = 0xFFFFFFFFu;
+
+inline uint32 PackVoxelSeedCell(const FIntVector& Cell)
+{
+    return uint32(Cell.X) | (uint32(Cell.Y) << 10) | (uint32(Cell.Z) << 20);
+}
+
+inline FIntVector UnpackVoxelSeedCell(uint32 Seed)
+{
+    return FIntVector(Seed & 0x3FFu, (Seed >> 10) & 0x3FFu, (Seed >> 20) & 0x3FFu);
+}
+
+// Separable exact EDT (Felzenszwalb & Huttenlocher), same envelope construction as EdtCS
+void ComputeVoxelSquaredEdt(const FIntVector& Dims, const TArray<bool>& Sites, TArray<float>& OutSquaredDistances);
+
+// Jump flooding over packed integer seeds, mirrors JfaCS with VOXEL_SEED_PACKED (same step schedule, tap order
+// and strict tie-breaking), so it reproduces the GPU distances exactly; the automation test
+// VoxelTest.Rendering.DistanceTransform.GpuJfaMatchesCpuMirror checks this against the tiled and untiled GPU paths
+void ComputeVoxelSquaredJfa(const FIntVector& Dims, const TArray<bool>& Sites, TArray<float>& OutSquaredDistances);
+
+// O(cells * sites) brute force, only meant for validating the above on small volumes
+void ComputeVoxelSquaredDistancesBruteForce(const FIntVector& Dims, const TArray<bool>& Sites, TArray<float>& OutSquaredDistances);
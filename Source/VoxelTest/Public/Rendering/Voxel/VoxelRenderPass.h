@@ -3,6 +3,7 @@
 #include "CoreMinimal.h"
 
 class FRDGBuilder;
+class FRHICommandListImmediate;
 
 void AddVoxelDebugRenderPass(
     FRDGBuilder& GraphBuilder,
@@ -17,3 +18,13 @@ void AddVoxelRaymarchPass(
     FRDGTextureRef SceneDepth,
     const void* OpaqueView);
 
+// Runs the GPU distance transform (EDT or JFA) over Dims cells with one isolated inside cell per site and reads the
+// distances back in the layout of the CPU reference (VoxelDistanceTransform.h). Render thread only; blocks on the GPU.
+void ComputeVoxelSquaredDistancesGpu(
+    FRHICommandListImmediate& RHICmdList,
+    const FIntVector& Dims,
+    const TArray<bool>& Sites,
+    bool bExactEdt,
+    bool bPackedSeeds,
+    bool bTiled,
+    TArray<float>& OutSquaredDistances);
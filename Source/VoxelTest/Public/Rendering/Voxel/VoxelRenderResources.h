@@ -2,35 +2,294 @@
 
 #include "CoreMinimal.h"
 #include "RenderResource.h"
+#include "RenderGraphResources.h"
+#include "RendererInterface.h"
 #include "RHI.h"
 #include "RHIResources.h"
+#include "RHIGPUReadback.h"
+#include <atomic>
+#include "Rendering/Voxel/VoxelBrickMap.h"
 
-// Minimal voxel render payload: only placement data
+// Half-open element range [Begin, End) of instance data pending GPU upload
+struct FVoxelDirtyRange
+{
+    int32 Begin = 0;
+    int32 End   = 0;
+
+    bool IsEmpty() const { return End <= Begin; }
+
+    void Add(int32 InBegin, int32 InEnd)
+    {
+        if (IsEmpty())
+        {
+            Begin = InBegin;
+            End   = InEnd;
+        }
+        else
+        {
+            Begin = FMath::Min(Begin, InBegin);
+            End   = FMath::Max(End, InEnd);
+        }
+    }
+
+    void Reset() { Begin = End = 0; }
+};
+
+// Half-open voxel-space box [Min, Max) of density cells changed since the last SDF build
+struct FVoxelDirtyBox
+{
+    FIntVector Min = FIntVector::ZeroValue;
+    FIntVector Max = FIntVector::ZeroValue;
+
+    bool IsEmpty() const { return Max.X <= Min.X || Max.Y <= Min.Y || Max.Z <= Min.Z; }
+
+    void Add(const FVoxelDirtyBox& Other)
+    {
+        if (Other.IsEmpty())
+        {
+            return;
+        }
+        if (IsEmpty())
+        {
+            *this = Other;
+            return;
+        }
+        Min = FIntVector(FMath::Min(Min.X, Other.Min.X), FMath::Min(Min.Y, Other.Min.Y), FMath::Min(Min.Z, Other.Min.Z));
+        Max = FIntVector(FMath::Max(Max.X, Other.Max.X), FMath::Max(Max.Y, Other.Max.Y), FMath::Max(Max.Z, Other.Max.Z));
+    }
+
+    void Reset() { Min = Max = FIntVector::ZeroValue; }
+};
+
+// Instance footprint scale shared by the density splat (VoxelDensity.usf) and the dirty boxes of local edits
+static constexpr float GVoxelOverlapMultiplier = 2.0f;
+
+// Cells an instance of normalized scale Scale reaches from its base cell when splatted; mirrors GetSplatFootprint
+inline int32 GetVoxelSplatReachCells(float Scale)
+{
+    const float SearchRadius = FMath::Max(Scale * 0.5f, 0.0f) * GVoxelOverlapMultiplier * 1.5f;
+    return FMath::Clamp(FMath::CeilToInt(SearchRadius + 0.5f), 0, 64);
+}
+
+// Minimal voxel render payload: only placement data, stored sparsely in 8^3 bricks
 // - Center: local-space center position of the voxel
 // - Scale:  uniform scale (edge length)
 struct FVoxelRenderResource : public FRenderResource
 {
-    TArray<FVector3f>  Centers;
-    TArray<float>      Scales;
+    FVoxelBrickMap Bricks;
 
     FVector3f VolumeMinLS = FVector3f::ZeroVector;
     FVector3f VolumeMaxLS = FVector3f::ZeroVector;
     float     VoxelSizeLS = 0.0f;
 
+    // Bumped on the render thread whenever placement data changes (grid build / animation)
+    uint32 DataVersion = 0;
+
+    // Process-unique identity; per-view raymarch history refers to volumes by (ResourceId, DataVersion) so it never
+    // follows a recycled address
+    const uint32 ResourceId = AllocateResourceId();
+
+    // Persistent GPU textures, reused across frames until DataVersion moves past BuiltVersion.
+    // The SDF is either dense (SdfTexture + per-8^3-block minimum SdfMinTexture) or a narrow-band brick atlas
+    // (SdfAtlasTexture + SdfIndirectionTexture). NormalTexture is only built for r.Voxel.Raymarch.NormalMethod=2.
+    // DensityTexture holds the resolved R16F density; the R32_UINT splat accumulation only lives during the build.
+    TRefCountPtr<IPooledRenderTarget> DensityTexture;
+    TRefCountPtr<IPooledRenderTarget> SdfTexture;
+    TRefCountPtr<IPooledRenderTarget> SdfMinTexture;
+    TRefCountPtr<IPooledRenderTarget> SdfAtlasTexture;
+    TRefCountPtr<IPooledRenderTarget> SdfIndirectionTexture;
+    TRefCountPtr<IPooledRenderTarget> NormalTexture;
+    // Final JFA seed field of the last build, the starting point of r.Voxel.DistanceTransform.WarmStart rebuilds
+    TRefCountPtr<IPooledRenderTarget> SeedTexture;
+    uint32     BuiltVersion     = MAX_uint32;
+    uint32     BuiltSettingsKey = 0;
+    FIntVector BuiltDimensions  = FIntVector::ZeroValue;
+
+    // Warm-started rebuilds since the last full JFA, bounded by r.Voxel.DistanceTransform.WarmStart.FullRebuildInterval
+    uint32 WarmBuildsSinceFull = 0;
+
+    // Narrow-band atlas capacity in bricks; grown from a readback of the allocation counter on overflow
+    uint32 SdfBrickCapacity = 0;
+    TUniquePtr<FRHIGPUBufferReadback> SdfBrickCountReadback;
+
+    // Cells whose density changed since the last build, for region-limited rebuilds; any change without a box
+    // (grid rebuild, animation) sets bSdfDirtyAll and forces a full rebuild
+    FVoxelDirtyBox SdfDirtyBox;
+    bool bSdfDirtyAll = false;
+
+    // Farthest any instance splats from its own cell, animation offsets included; bounds the atlas slots a region
+    // splat has to visit. Kept up to date by UVoxelVolume (normalized scales never exceed 1).
+    int32 SplatReachCells = GetVoxelSplatReachCells(1.0f);
+
+    // Frames a pending rebuild has been pushed back by r.Voxel.RebuildBudget; ages its scheduling priority
+    uint32 RebuildDeferredFrames = 0;
+
+    // Persistent GPU brick atlas in the same layout as Bricks (float3 / float per atlas cell, int4 per slot)
+    TRefCountPtr<FRDGPooledBuffer> CentersBuffer;
+    TRefCountPtr<FRDGPooledBuffer> ScalesBuffer;
+    TRefCountPtr<FRDGPooledBuffer> BrickCoordsBuffer;
+    FVoxelDirtyRange CentersDirty;
+    FVoxelDirtyRange ScalesDirty;
+    FVoxelDirtyRange BrickCoordsDirty;
+
     bool IsValid() const
     {
-        return Centers.Num() == Scales.Num() && Centers.Num() > 0;
+        return Bricks.Centers.Num() == Bricks.Scales.Num() && !Bricks.IsEmpty();
+    }
+
+    FIntVector GetVolumeDimensions() const
+    {
+        const FVector3f ExtentLS = VolumeMaxLS - VolumeMinLS;
+        const float Size = FMath::Max(VoxelSizeLS, UE_KINDA_SMALL_NUMBER);
+        return FIntVector(
+            FMath::Max(1, FMath::RoundToInt(ExtentLS.X / Size)),
+            FMath::Max(1, FMath::RoundToInt(ExtentLS.Y / Size)),
+            FMath::Max(1, FMath::RoundToInt(ExtentLS.Z / Size)));
+    }
+
+    // Identity of the placement data an SDF build is made from. Every proxy referencing this resource shares the
+    // one build per frame made under this key, however many components place the same UVoxelVolume.
+    uint64 GetBuildKey() const
+    {
+        return (uint64(ResourceId) << 32) | DataVersion;
     }
 
-    void InitializeInstances(const TArray<FVector3f>& InCenters, const TArray<float>& InScales)
+    void MarkDirty()
     {
-        Centers    = InCenters;
-        Scales     = InScales;
+        ++DataVersion;
+        bSdfDirtyAll = true;
+    }
+
+    void MarkRegionDirty(const FVoxelDirtyBox& Box)
+    {
+        ++DataVersion;
+        SdfDirtyBox.Add(Box);
+    }
+
+    // Called once a build has caught up with DataVersion
+    void ClearSdfDirty()
+    {
+        SdfDirtyBox.Reset();
+        bSdfDirtyAll = false;
+    }
+
+    // A complete SDF of some earlier DataVersion that can stay on screen while its rebuild is pending
+    bool HasDisplayableSdf(const FIntVector& VolumeDimensions, uint32 SettingsKey) const
+    {
+        return DensityTexture.IsValid()
+            && ((SdfTexture.IsValid() && SdfMinTexture.IsValid()) || SdfAtlasTexture.IsValid())
+            && BuiltVersion != MAX_uint32
+            && BuiltSettingsKey == SettingsKey
+            && BuiltDimensions == VolumeDimensions;
+    }
+
+    bool IsGpuCacheValid(const FIntVector& VolumeDimensions, uint32 SettingsKey) const
+    {
+        return HasDisplayableSdf(VolumeDimensions, SettingsKey) && BuiltVersion == DataVersion;
+    }
+
+    void InitializeBricks(FVoxelBrickMap&& InBricks)
+    {
+        Bricks = MoveTemp(InBricks);
+        CentersDirty.Add(0, Bricks.NumAtlasCells());
+        ScalesDirty.Add(0, Bricks.NumAtlasCells());
+        BrickCoordsDirty.Add(0, Bricks.NumSlots());
+        MarkDirty();
+    }
+
+    // Replace atlas centers (same slot layout), recording only the span that actually changed
+    void UpdateCenters(TArray<FVector3f>&& InCenters)
+    {
+        UpdateInstanceArray(Bricks.Centers, MoveTemp(InCenters), CentersDirty);
+    }
+
+    void UpdateScales(TArray<float>&& InScales)
+    {
+        UpdateInstanceArray(Bricks.Scales, MoveTemp(InScales), ScalesDirty);
+    }
+
+    // Local edit: frees individual cells through the brick map, recycling the slot of every brick left empty.
+    // DirtyBox covers every cell their splats can have reached, so the next SDF build may be limited to it.
+    void ClearCells(const TArray<FIntVector>& Cells, const FVoxelDirtyBox& DirtyBox)
+    {
+        bool bChanged = false;
+        for (const FIntVector& Cell : Cells)
+        {
+            if (!Bricks.IsCellOccupied(Cell)) continue;
+            const int32 AtlasIndex = Bricks.FindAtlasIndex(Cell);
+            const int32 Slot = AtlasIndex / FVoxelBrickMap::CellsPerBrick;
+            Bricks.ClearCell(Cell);
+            CentersDirty.Add(AtlasIndex, AtlasIndex + 1);
+            ScalesDirty.Add(AtlasIndex, AtlasIndex + 1);
+            if (Bricks.BrickCoords[Slot].W == 0)
+            {
+                BrickCoordsDirty.Add(Slot, Slot + 1);
+            }
+            bChanged = true;
+        }
+        if (bChanged)
+        {
+            MarkRegionDirty(DirtyBox);
+        }
     }
 
     void ReleaseAll()
     {
-        Centers.Reset();
-        Scales.Reset();
+        Bricks.Reset();
+        DensityTexture.SafeRelease();
+        SdfTexture.SafeRelease();
+        SdfMinTexture.SafeRelease();
+        SdfAtlasTexture.SafeRelease();
+        SdfIndirectionTexture.SafeRelease();
+        NormalTexture.SafeRelease();
+        SeedTexture.SafeRelease();
+        WarmBuildsSinceFull = 0;
+        BuiltVersion = MAX_uint32;
+        BuiltSettingsKey = 0;
+        BuiltDimensions = FIntVector::ZeroValue;
+        SdfBrickCapacity = 0;
+        SdfBrickCountReadback.Reset();
+        RebuildDeferredFrames = 0;
+        SdfDirtyBox.Reset();
+        bSdfDirtyAll = false;
+        CentersBuffer.SafeRelease();
+        ScalesBuffer.SafeRelease();
+        BrickCoordsBuffer.SafeRelease();
+        CentersDirty.Reset();
+        ScalesDirty.Reset();
+        BrickCoordsDirty.Reset();
+    }
+
+private:
+    static uint32 AllocateResourceId()
+    {
+        static std::atomic<uint32> NextResourceId{ 1 };
+        return NextResourceId.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    template<typename ElementType>
+    void UpdateInstanceArray(TArray<ElementType>& Current, TArray<ElementType>&& Incoming, FVoxelDirtyRange& Dirty)
+    {
+        const int32 Num = Incoming.Num();
+        if (Num != Current.Num())
+        {
+            Current = MoveTemp(Incoming);
+            Dirty.Add(0, Num);
+            MarkDirty();
+            return;
+        }
+
+        int32 First = 0;
+        while (First < Num && Current[First] == Incoming[First]) { ++First; }
+        if (First == Num)
+        {
+            return;
+        }
+        int32 Last = Num - 1;
+        while (Last > First && Current[Last] == Incoming[Last]) { --Last; }
+
+        Current = MoveTemp(Incoming);
+        Dirty.Add(First, Last + 1);
+        MarkDirty();
     }
 };
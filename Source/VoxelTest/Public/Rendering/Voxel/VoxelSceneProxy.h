@@ -62,8 +62,7 @@ private:
     FDebugMeshRHI DebugMesh;
     void BuildDebugMesh_RenderThread(
         FRHICommandListImmediate& RHICmdList,
-        const TArray<FVector3f>& Centers,
-        const TArray<float>& Scales);
+        const FVoxelBrickMap& Bricks);
     static TArray<FVoxelSceneProxy*, TInlineAllocator<64>> GProxies_RT;
     static uint64 GCurrentEpoch_RT;
     static uint64 GActiveEpoch_RT;
@@ -12,8 +12,10 @@ class UVoxelVolume : public UObject
 public:
     TSharedPtr<struct FVoxelRenderResource> RenderResources;
 
+    // Repeated calls with the built RegionSize/BlockSize are dropped unless bForceRebuild, which also restores
+    // instances removed by CarveSpheres
     UFUNCTION(BlueprintCallable, Category="Voxel")
-    void BuildVoxelGrid(const FVector& RegionSize, float BlockSize);
+    void BuildVoxelGrid(const FVector& RegionSize, float BlockSize, bool bForceRebuild = false);
 
     // Runtime animation helpers
     UFUNCTION(BlueprintCallable, Category="Voxel|Runtime")
@@ -22,10 +24,28 @@ public:
     UFUNCTION(BlueprintCallable, Category="Voxel|Runtime")
     void AnimateCenters(float TimeSeconds, float Amplitude = 5.0f, float Frequency = 0.5f);
 
+    // Removes every instance whose base center lies within RadiusLS of a center (local space). The edits of one
+    // call reach the render thread as a single dirty box, so the SDF is only rebuilt around them.
+    UFUNCTION(BlueprintCallable, Category="Voxel|Runtime")
+    void CarveSpheres(const TArray<FVector>& CentersLS, float RadiusLS);
+
+    UFUNCTION(BlueprintCallable, Category="Voxel|Runtime")
+    void CarveSphere(const FVector& CenterLS, float RadiusLS);
+
     virtual void BeginDestroy() override;
 
 private:
     // Cached initial layout for runtime animation on GT
-    TArray<FVector3f> BaseCenters_GT;
-    TArray<float>     BaseScales_GT;
+    FVoxelBrickMap BaseBricks_GT;
+    FIntVector     GridDims_GT = FIntVector::ZeroValue;
+
+    // Every component placing this asset builds and animates it from its own OnRegister/Tick. Repeats with the same
+    // inputs are dropped so the shared render resource (and its GPU SDF) is built and updated once, not per component.
+    FVector   BuiltRegionSize_GT = FVector::ZeroVector;
+    float     BuiltBlockSize_GT  = 0.0f;
+    FVector3f LastScaleAnim_GT   = FVector3f(-1.0f);   // (TimeSeconds, Amplitude, Frequency)
+    FVector3f LastCenterAnim_GT  = FVector3f(-1.0f);
+
+    // Largest per-axis offset AnimateCenters has applied since the grid was built; widens the dirty boxes of edits
+    float MaxCenterOffset_GT = 0.0f;
 };